@@ -0,0 +1,100 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <SFML/Audio.hpp>
+#include "SpriteBatch.hpp"
+#include "AssetPack.hpp"
+
+// Imágenes de juego que van al atlas. El valor es el índice del arreglo.
+enum class SpriteId : unsigned { Ship, Asteroid, Bullet, Heart, Count };
+
+// Identificador de una textura suelta (fondos grandes que no van al atlas).
+typedef int TextureHandle;
+const TextureHandle INVALID_TEXTURE = -1;
+
+// Carga las imágenes del juego y las empaqueta en una sola textura (atlas) para
+// que todos los sprites de la partida compartan la misma textura y se dibujen
+// en un solo lote. Las búsquedas son índices de arreglo, sin cadenas.
+//
+// La lectura y decodificación de archivos va en hilos de fondo; lo que toca la
+// GPU (subir texturas, armar el atlas) se hace en el hilo principal dentro de
+// poll(), a medida que cada carga termina.
+//
+// Con un paquete montado (mountPack) cada ruta se busca primero en él: las
+// imágenes ya vienen en RGBA y los sonidos cortos en PCM. Lo que no esté en el
+// paquete se lee del disco como siempre.
+//
+// Uso: queueSprite()/queueTexture()/queueTask() por cada archivo (todo antes de
+// startLoading()), startLoading() una vez, poll() cada frame hasta que devuelva true, luego sprite()/texture().
+class AssetManager {
+public:
+    AssetManager() = default;
+    ~AssetManager();
+    AssetManager(const AssetManager&) = delete;
+    AssetManager& operator=(const AssetManager&) = delete;
+
+    // Abre el paquete de recursos (ver AssetPack.hpp); false si no hay o no es válido.
+    bool mountPack(const std::string& path);
+    const AssetPack& pack() const { return archive; }
+    // Fuente y sonido desde el paquete o del disco; se pueden usar en queueTask().
+    bool loadFont(sf::Font& font, const std::string& path) const;
+    bool loadSound(sf::SoundBuffer& buffer, const std::string& path) const;
+
+    // Imagen para el atlas; si no existe, ese sprite queda inválido.
+    void queueSprite(SpriteId id, const std::string& path);
+    // Textura suelta. El identificador vale desde ya; texture() da nullptr
+    // hasta que se sube o si el archivo no se pudo leer.
+    TextureHandle queueTexture(const std::string& path);
+    // Cualquier otra carga: `work` corre en un hilo de fondo y `done(ok)`
+    // después en el hilo principal, desde poll().
+    void queueTask(std::function<bool()> work, std::function<void(bool)> done = nullptr);
+
+    // Arranca los hilos de carga (0 = uno por núcleo, al menos dos para
+    // solapar disco y decodificación).
+    void startLoading(unsigned threads = 0);
+    // Recoge lo terminado y lo sube a la GPU; true cuando ya está todo (atlas incluido).
+    bool poll();
+    // Fracción de cargas recogidas, en [0, 1].
+    float progress() const;
+    // No empieza más cargas y espera a las que están en curso (salir durante la carga).
+    void stopLoading();
+
+    const SpriteRegion& sprite(SpriteId id) const { return regions[(size_t)id]; }
+    const sf::Texture& atlasTexture() const { return atlas; }
+    const sf::Texture* texture(TextureHandle h) const;
+
+private:
+    // Empaqueta las imágenes leídas y sube el atlas a la GPU.
+    bool buildAtlas();
+    void loaderLoop();
+
+    struct LoadTask {
+        std::function<bool()> work;
+        std::function<void(bool)> done;
+        bool ok = false;
+        bool collected = false;           // done() ya se llamó
+        std::atomic<bool> finished{false};
+    };
+    AssetPack archive;
+    std::vector<std::unique_ptr<LoadTask>> tasks;
+    std::atomic<size_t> nextTask{0};
+    std::vector<std::thread> loaders;
+    size_t collected = 0;
+    bool atlasBuilt = false;
+
+    static const size_t SPRITE_COUNT = (size_t)SpriteId::Count;
+    std::array<sf::Image, SPRITE_COUNT> images;
+    std::array<bool, SPRITE_COUNT> loaded{};
+    std::array<SpriteRegion, SPRITE_COUNT> regions;
+    sf::Texture atlas;
+
+    std::vector<std::unique_ptr<sf::Texture>> textures;
+    std::vector<sf::Image> textureImages; // decodificadas, a la espera de subirse
+    std::vector<bool> textureReady;
+};
@@ -0,0 +1,54 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Archivo empaquetado con todos los recursos (make pack). Se abre con mmap y
+// las texturas y sonidos se crean directamente desde los bytes mapeados: las
+// imágenes ya vienen en RGBA y los efectos cortos en PCM, sin decodificar nada
+// al arrancar y sin una apertura de archivo por recurso.
+//
+// Formato (enteros little-endian):
+//   cabecera: "APAK", versión u32, entradas u32, desplazamiento del índice u32
+//   datos de cada entrada, alineados a 16 bytes
+//   índice, ordenado por nombre: por entrada, largo del nombre u16, nombre,
+//   tipo u8, desplazamiento u32, tamaño u32, a u32, b u32
+// a/b: ancho/alto para Rgba; frecuencia/canales para Pcm (muestras i16).
+// Los nombres son las mismas rutas que usa el juego ("assets/arial.ttf").
+enum class PackEntryKind : std::uint8_t { Raw, Rgba, Pcm };
+
+struct PackEntry {
+    std::string name;
+    PackEntryKind kind = PackEntryKind::Raw;
+    const std::uint8_t* data = nullptr; // dentro del mapeo
+    std::uint32_t size = 0;
+    std::uint32_t a = 0, b = 0;
+};
+
+const char ASSET_PACK_MAGIC[4] = {'A','P','A','K'};
+const std::uint32_t ASSET_PACK_VERSION = 1;
+const std::uint32_t ASSET_PACK_ALIGN = 16;
+
+class AssetPack {
+public:
+    AssetPack() = default;
+    ~AssetPack();
+    AssetPack(const AssetPack&) = delete;
+    AssetPack& operator=(const AssetPack&) = delete;
+
+    // Mapea el archivo y lee el índice; false si no existe o no es válido.
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return base != nullptr; }
+    // Entrada por ruta, o nullptr. Los bytes valen mientras el paquete siga abierto.
+    const PackEntry* find(const std::string& name) const;
+
+private:
+    const std::uint8_t* base = nullptr;
+    size_t length = 0;
+#ifdef _WIN32
+    void* mapping = nullptr;
+#endif
+    std::vector<PackEntry> entries;
+};
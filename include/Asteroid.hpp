@@ -1,15 +1,18 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include "SpriteBatch.hpp"
 
 // Asteroide con colisión circular básica y envolvimiento de pantalla (wrap-around).
+// Describe un asteroide suelto; en el mundo viven en AsteroidStore (SoA).
 struct Asteroid {
     sf::Vector2f position;
+    sf::Vector2f prevPosition; // posición del tick anterior, para interpolar al dibujar
     sf::Vector2f velocity;
     float radius = 24.f;
     int size = 2; // 2 = grande, 1 = mediano, 0 = pequeño
-    const sf::Texture* texture = nullptr;
+    SpriteRegion sprite; // imagen en el atlas (opcional)
     bool alive = true;
 
-    void update(float dt);
-    void draw(sf::RenderTarget& target) const;
+    // `alpha` indica cuánto se avanzó entre el tick anterior y el actual.
+    void draw(SpriteBatch& batch, float alpha = 1.f) const;
 };
@@ -0,0 +1,12 @@
+#pragma once
+#include "Ship.hpp"
+
+class World;
+
+// Piloto automático: la entrada que daría un jugador sencillo a `ship` en el
+// estado actual de `world`. Apunta al asteroide más cercano (midiendo a través
+// de los bordes y con adelanto: donde estará cuando llegue la bala), dispara
+// cuando la puntería es buena y el asteroide está a tiro, y empuja hacia él si
+// está lejos y la nave va despacio. No usa azar: la misma partida da la misma
+// entrada, así que lo que juega se puede grabar (--record) y repetir.
+ShipInput autopilotInput(const World& world, const Ship& ship);
@@ -0,0 +1,55 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <vector>
+#include "Random.hpp"
+
+class MenuUi;
+
+// Fondo de la partida y del menú. Lo que no cambia (la imagen escalada, y en
+// el menú también el título) se pinta una vez en un sf::RenderTexture a la
+// resolución de la ventana y después se dibuja como un solo sprite; solo se
+// vuelve a pintar si cambia el tamaño de la ventana. Encima va un campo de
+// estrellas en capas que se desplazan contra la velocidad de la nave
+// (paralaje), cada capa un sf::VertexArray y una llamada de dibujo.
+class Backdrop {
+public:
+    // `background` puede ser nulo (fondo liso). Tamaño lógico de la escena.
+    void layout(const sf::Texture* background, float width, float height);
+    // Resolución real de la ventana; si cambió, las capas fijas se repintan al dibujar.
+    void resize(sf::Vector2u pixels);
+    sf::Vector2u size() const { return pixels; }
+    // Desplaza las estrellas: las capas más cercanas se mueven más.
+    void update(float dt, const sf::Vector2f& shipVelocity);
+
+    // Fondo de la partida. Devuelve las llamadas de dibujo.
+    unsigned draw(sf::RenderTarget& target);
+    // Fondo del menú con el título ya pintado en la capa fija.
+    unsigned drawMenu(sf::RenderTarget& target, const MenuUi& menu);
+
+private:
+    static const int STAR_LAYERS = 3;
+    struct StarLayer {
+        std::vector<sf::Vector2f> stars; // posición base en [0, ancho) x [0, alto)
+        sf::Vector2f offset;
+        float parallax = 0.f;            // fracción de la velocidad de la nave
+        float size = 1.f;
+        sf::Color color;
+        sf::VertexArray vertices{sf::Triangles};
+    };
+
+    // Repinta `layer` si hace falta: fondo escalado y, en el menú, el título.
+    void rebuild(sf::RenderTexture& layer, sf::Sprite& sprite, bool& dirty, const MenuUi* menu);
+    unsigned drawStars(sf::RenderTarget& target);
+
+    const sf::Texture* background = nullptr;
+    float width = 0.f, height = 0.f;
+    sf::Vector2u pixels;
+
+    sf::RenderTexture gameLayer, menuLayer;
+    sf::Sprite gameSprite, menuSprite;
+    bool gameDirty = true, menuDirty = true;
+
+    std::array<StarLayer, STAR_LAYERS> starLayers;
+    Rng rng;
+};
@@ -0,0 +1,49 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class World;
+
+// Motor de física alternativo para World: asteroides, balas y nave son cuerpos
+// de un b2World (Box2D 2.4) que integra y busca contactos con su árbol
+// dinámico. Los asteroides rebotan entre sí; balas y nave no rebotan (el
+// contacto se anula en PreSolve y solo se anota), y las balas usan el CCD de
+// Box2D. Los puntos, las divisiones y las vidas los sigue aplicando World con
+// las mismas reglas que sin este motor.
+//
+// Los pools de World siguen siendo el estado de referencia: en cada paso se
+// crean o mueven los cuerpos de lo que cambió en ellos (altas, bajas, la nave
+// reaparecida) y después del paso se copian de vuelta posiciones y
+// velocidades, envolviendo por los bordes con los mismos márgenes.
+//
+// Se compila con make BOX2D=1 (por defecto); con BOX2D=0 available() da false
+// y el juego y las herramientas rechazan la opción.
+class Box2DPhysics {
+public:
+    struct BulletHit { std::uint32_t bullet, asteroid; };
+
+    static bool available();
+
+    Box2DPhysics();
+    ~Box2DPhysics();
+    Box2DPhysics(const Box2DPhysics&) = delete;
+    Box2DPhysics& operator=(const Box2DPhysics&) = delete;
+
+    // Sincroniza los cuerpos con los pools de `world`, avanza `dt` y copia el
+    // resultado de vuelta (también la posición anterior, para interpolar).
+    void step(World& world, float dt);
+
+    // Contactos del último step(), ordenados por bala y asteroide, sin repetir.
+    const std::vector<BulletHit>& bulletHits() const { return hits; }
+    // Asteroides que tocaron la nave en el último step(), ordenados.
+    const std::vector<std::uint32_t>& shipHits() const { return shipContacts; }
+    size_t bodyCount() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl;
+    std::vector<BulletHit> hits;
+    std::vector<std::uint32_t> shipContacts;
+};
@@ -1,12 +1,15 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 
+class SpriteBatch;
+
+// Describe una bala suelta; en el mundo viven en BulletStore (SoA).
 struct Bullet {
     sf::Vector2f position;
+    sf::Vector2f prevPosition; // posición del tick anterior, para interpolar al dibujar
     sf::Vector2f velocity;
     float lifetime = 2.0f;
     float radius = 3.f;
     bool alive = true;
-    void update(float dt);
-    void draw(sf::RenderTarget& target) const;
+    void draw(SpriteBatch& batch, float alpha = 1.f) const;
 };
@@ -0,0 +1,102 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+#include "Asteroid.hpp"
+#include "Bullet.hpp"
+
+// Almacenamiento en arreglos separados (SoA) para las entidades numerosas.
+// Cada campo vive en su propio arreglo contiguo para que los núcleos de
+// SimdKernels los recorran de corrido. `Asteroid` y `Bullet` siguen siendo la
+// forma de crear (spawn) o leer (get) una entidad suelta.
+//
+// Son pools de capacidad fija: toda la memoria se pide en init() y los huecos
+// se reutilizan con una lista libre, así que jugar no pide memoria. Los
+// índices (slots) son estables mientras la entidad vive. Los slots muertos
+// entre 0 y slots() tienen alive = 0 y los recorridos los saltan.
+//
+// World no llama spawn()/release() en medio del tick: encola los cambios y los
+// aplica juntos al final (World::flushCommands).
+
+struct BulletStore {
+    std::vector<float> x, y;
+    std::vector<float> prevX, prevY; // tick anterior, para interpolar al dibujar
+    std::vector<float> vx, vy;
+    std::vector<float> lifetime;
+    std::vector<std::uint8_t> alive;
+    std::vector<std::uint8_t> generation; // sube en cada spawn(): distingue un slot reutilizado
+    float radius = 3.f;   // todas las balas miden lo mismo
+    float wrapMargin = 10.f;
+
+    // Pide la memoria de `capacity` balas y deja el pool vacío.
+    void init(size_t capacity);
+    void clear();
+    // Ocupa un slot libre; devuelve su índice o -1 si el pool está lleno.
+    int spawn(const Bullet& b);
+    // Devuelve el slot a la lista libre.
+    void release(std::uint32_t slot);
+    // Tras escribir los arreglos directamente (al restaurar un WorldState):
+    // slots() pasa a ser `count` y la lista libre se rehace con los slots
+    // muertos por debajo, así las altas siguientes ocupan los mismos slots.
+    void resetSlots(size_t count);
+    Bullet get(size_t i) const;
+
+    size_t capacity() const { return x.size(); }
+    size_t slots() const { return top; }    // recorrer [0, slots())
+    size_t live() const { return used; }    // slots ocupados
+    bool empty() const { return used == 0; }
+
+    // Integra, envuelve en pantalla y descuenta el tiempo de vida. Las balas
+    // que se agotan quedan con alive = 0 y sus slots se escriben en `expired`
+    // (capacity() elementos como máximo); devuelve cuántas fueron.
+    size_t update(float dt, float width, float height, std::uint32_t* expired);
+    // Las dos mitades de update(), para repartir la integración por rangos
+    // entre hilos (ver World::step): solo el tiempo de vida...
+    size_t tickLifetimes(float dt, std::uint32_t* expired);
+    // ...y solo guardar la posición anterior, integrar y envolver [begin, end).
+    void integrate(float dt, float width, float height, size_t begin, size_t end);
+
+private:
+    std::vector<std::uint32_t> freeList;
+    size_t top = 0;
+    size_t used = 0;
+};
+
+struct AsteroidStore {
+    std::vector<float> x, y;
+    std::vector<float> prevX, prevY; // tick anterior, para interpolar al dibujar
+    std::vector<float> vx, vy;
+    std::vector<float> radius;       // también es el margen de envolvimiento
+    std::vector<std::int8_t> size;   // 2 = grande, 1 = mediano, 0 = pequeño
+    std::vector<std::uint8_t> alive;
+    std::vector<std::uint8_t> generation; // sube en cada spawn(): distingue un slot reutilizado
+    SpriteRegion sprite; // compartida por todos
+
+    // Pide la memoria de `capacity` asteroides y deja el pool vacío.
+    void init(size_t capacity);
+    void clear();
+    // Ocupa un slot libre; devuelve su índice o -1 si el pool está lleno.
+    int spawn(const Asteroid& a);
+    // Devuelve el slot a la lista libre.
+    void release(std::uint32_t slot);
+    // Tras escribir los arreglos directamente (al restaurar un WorldState):
+    // slots() pasa a ser `count` y la lista libre se rehace con los slots
+    // muertos por debajo, así las altas siguientes ocupan los mismos slots.
+    void resetSlots(size_t count);
+    Asteroid get(size_t i) const;
+
+    size_t capacity() const { return x.size(); }
+    size_t slots() const { return top; }    // recorrer [0, slots())
+    size_t live() const { return used; }    // slots ocupados
+    bool empty() const { return used == 0; }
+
+    // Integra y envuelve en pantalla.
+    void update(float dt, float width, float height);
+    // Lo mismo solo en los slots [begin, end).
+    void integrate(float dt, float width, float height, size_t begin, size_t end);
+
+private:
+    std::vector<std::uint32_t> freeList;
+    size_t top = 0;
+    size_t used = 0;
+};
@@ -1,39 +1,119 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include <SFML/Audio.hpp>
+#include <atomic>
+#include <chrono>
+#include <future>
 #include <string>
+#include <thread>
 #include <vector>
-#include <map>
 #include <memory>
-#include "Ship.hpp"
-#include "Asteroid.hpp"
-#include "Bullet.hpp"
+#include "World.hpp"
+#include "SpriteBatch.hpp"
+#include "AssetManager.hpp"
+#include "Ui.hpp"
+#include "Profiler.hpp"
+#include "Replay.hpp"
+#include "Random.hpp"
+#include "MusicPlayer.hpp"
+#include "SfxPool.hpp"
+#include "Particles.hpp"
+#include "Backdrop.hpp"
+#include "TripleBuffer.hpp"
+#include "WorldSnapshot.hpp"
+#include "Box2DPhysics.hpp"
+#include "NetServer.hpp"
+#include "NetClient.hpp"
+#include "RewindBuffer.hpp"
+#include "SoakMonitor.hpp"
 
 // Núcleo simple de un juego estilo Asteroides. La API pública es mínima:
 // crea `Game` y llama a `run()`.
 class Game {
 public:
     Game();
+    ~Game();
     void run();
 
-    // Intenta cargar una textura y guardarla bajo `id`. Devuelve puntero o `nullptr` en caso de fallo.
-    const sf::Texture* loadTexture(const std::string& id, const std::string& path);
+    // La simulación avanza a paso fijo: `hz` ticks por segundo, independiente de los FPS.
+    void setTickRate(float hz);
+    // Máximo de ticks por frame para recuperar atraso; el resto se descarta.
+    void setMaxCatchUpSteps(int steps);
+    // Límite de FPS de la ventana (0 = sin límite, usar vsync).
+    void setFrameLimit(unsigned fps);
+    // Pantalla completa a la resolución del escritorio; el mundo conserva su
+    // proporción con bandas negras.
+    void setFullscreen(bool enabled);
+    // Resolución dinámica: la escena se dibuja a una fracción de los píxeles
+    // (50-100 %) que se ajusta sola para mantener `targetFps` (0 = desactivada).
+    void setDynamicResolution(float targetFps);
+    // Graba el perfil de todos los frames y lo escribe en `path` al salir
+    // (.json: eventos para chrome://tracing; otra extensión: CSV).
+    void setProfileOutput(const std::string& path);
+    // Graba cada partida (semilla + entrada por tick) en `path` al terminarla.
+    void setRecordOutput(const std::string& path);
+    // Empieza a jugar la repetición de `path` en lugar de leer el teclado.
+    bool loadReplay(const std::string& path);
+    // Ticks de repetición por tick de tiempo real (2 = el doble de rápido).
+    void setReplaySpeed(float speed);
+    // Hilos de trabajo para la simulación además del principal (0 = según los núcleos).
+    void setWorkerThreads(unsigned count);
+    // Dibuja en un hilo aparte a partir de la última instantánea publicada;
+    // eventos, entrada y simulación siguen en el hilo principal a su ritmo.
+    void setRenderThread(bool enabled);
+    // Integración y contactos con Box2D (asteroides que rebotan entre sí) en
+    // lugar del motor propio. false si el binario se compiló sin Box2D.
+    bool setBox2DPhysics(bool enabled);
+    // Partida en red (ver NetServer.hpp): hospeda en el puerto UDP `port`
+    // mandando `snapshotRate` instantáneas por segundo a cada cliente...
+    bool hostGame(unsigned short port, float snapshotRate);
+    // ...o se une a la de `host`:`port`. false si no se pudo abrir el socket.
+    bool joinGame(const std::string& host, unsigned short port);
+    // Archivo de la partida guardada con F5 y cargada con F9 ("partida.sav").
+    void setSessionFile(const std::string& path);
+    // El piloto automático (ver Autopilot.hpp) maneja la nave en lugar del
+    // teclado y reinicia la partida al perder, como la R.
+    void setAutopilot(bool enabled);
+    // Prueba de resistencia: empieza a jugar sin menú con el piloto automático,
+    // anota memoria, entidades y tiempos (ver SoakMonitor.hpp) y cierra al
+    // cumplir la duración. soakPassed() da el resultado después de run().
+    void setSoak(const SoakLimits& limits);
+    bool soakPassed() const { return soakOk; }
 
 private:
+    // Termina de preparar lo que depende de los recursos cargados (interfaz, sprites, música).
+    void finishLoading();
+    // Pantalla de carga: solo una barra de progreso.
+    void renderLoading();
     void processEvents();
-    void update(float dt);
-    void render();
-    void spawnAsteroids(unsigned n);
-    void resetLevel();
-    bool circleCollision(const sf::Vector2f& aPos, float aR, const sf::Vector2f& bPos, float bR);
-    
-    // Sistema de música
-    void loadMusicTracks();
-    void playRandomTrack();
-    void updateMusic();
-    void toggleMusicPlayPause();
-    void playNextTrack();
-    void playPrevTrack();
+    // Un tick de simulación de duración fija.
+    void tick(float dt);
+    // `alpha` en [0,1]: fracción del siguiente tick ya acumulada, para interpolar.
+    struct FrameSnapshot;
+    void render(const FrameSnapshot& frame, float alpha);
+    // Bucle del hilo de dibujo (ver setRenderThread).
+    void renderLoop();
+    // Lee el teclado y lo traduce a los controles de la nave.
+    ShipInput readInput() const;
+    // Nueva partida con semilla propia (o la de la repetición) y grabación si se pidió.
+    void startGame();
+    // Otra partida tras perder (R o el piloto automático).
+    void restartGame();
+    // Guarda la grabación o comprueba la repetición al terminar la partida.
+    void finishGame();
+    // Rebobinado y partida guardada: solo en partidas locales que no son repeticiones.
+    bool canRewind() const { return !client && !server && !replaying; }
+    // F5: copia el estado y lo escribe en un hilo de fondo. F9: lo carga.
+    void saveSession();
+    void loadSession();
+    // Recoge el resultado de la escritura de F5 (en este hilo) si terminó o si `wait`.
+    void collectSessionSave(bool wait);
+    // Partículas de lo ocurrido en el último tick (explosiones, motor).
+    void emitEffects();
+    // Textura de la escena para la resolución dinámica; false si no se pudo crear.
+    bool prepareSceneTarget(sf::Vector2u pixels);
+    // Sube o baja renderScale según el tiempo de dibujo medido y el presupuesto.
+    void adaptRenderScale(float seconds);
 
     // Menú y estados
     enum class State { Menu, Playing, GameOver };
@@ -41,44 +121,113 @@ private:
     int menuSelection = 0; // 0 = Jugar, 1 = Salir.
     const std::vector<std::string> menuOptions = {"Jugar", "Salir"};
     const sf::Texture* backgroundTexture = nullptr;
+    TextureHandle backgroundHandle = INVALID_TEXTURE;
+    bool quitRequested = false; // la ventana se cierra al salir de run(), no a mitad de un frame
+
+    // Todo lo que lee render(): el mundo y el estado de la interfaz al final de
+    // los ticks del frame. Con hilo de dibujo, render() no toca nada más de Game.
+    struct FrameSnapshot {
+        WorldSnapshot world;
+        ParticleSystem particles;
+        State state = State::Menu;
+        int menuSelection = 0;
+        float musicVolume = 0.f;
+        bool musicPlaying = false;
+        bool showDebug = false;
+        sf::Vector2u windowPixels;  // tamaño real de la ventana (capas fijas del fondo)
+        std::string profileText;
+        float alpha = 1.f;          // fracción del tick acumulada al publicar
+        float tickSeconds = 1.f;    // duración real de un tick (con la velocidad de repetición)
+        std::chrono::steady_clock::time_point published;
+    };
+    void captureFrame(FrameSnapshot& frame, float alpha, float tickSeconds);
+    FrameSnapshot frame;                  // sin hilo de dibujo: se rellena y dibuja en cada frame
+    TripleBuffer<FrameSnapshot> frames;   // con hilo de dibujo: simulación -> dibujo
+    bool renderThreaded = false;
+    std::thread renderThread;
+    std::atomic<bool> rendering{false};
 
     sf::RenderWindow window;
-    std::map<std::string,sf::Texture> textures;
+    unsigned frameLimit = 60;  // se vuelve a aplicar al recrear la ventana
+    bool fullscreen = false;
+    // Atlas de sprites y texturas sueltas, por identificador (sin búsquedas por nombre)
+    AssetManager assets;
 
-    Ship player;
-    std::vector<Asteroid> asteroids;
-    std::vector<Bullet> bullets;
+    // Simulación (nave, asteroides, balas, puntos); Game solo la dibuja y la hace sonar.
+    World world;
+    // Hilos que reparten integración y colisiones de los ticks pesados
+    std::unique_ptr<JobSystem> jobs;
+    std::unique_ptr<Box2DPhysics> physics; // solo con setBox2DPhysics(true)
+    // Red: como anfitrión se simula y se envía; como cliente no se simula, se
+    // muestra lo que llega del anfitrión (NetClient rellena `world`).
+    std::unique_ptr<NetServer> server;
+    std::unique_ptr<NetClient> client;
+    float tickRate = 60.f;
+    int maxCatchUpSteps = 5;
 
     sf::Font font;
-    sf::Text hud;
+    bool fontLoaded = false;
+    // Interfaz retenida: se acomoda en el constructor y solo se regenera al cambiar
+    Hud hud;
+    MenuUi menu;
+    GameOverUi gameOverUi;
+
+    // Balas, asteroides y nave se dibujan en lotes (pocas llamadas por frame)
+    SpriteBatch batch;
+    // Fondo en capas fijas y estrellas con paralaje (lo usa solo render())
+    Backdrop backdrop;
+    sf::Clock backdropClock;
+    sf::Vector2u windowPixels; // lo actualiza el evento Resized en el hilo principal
+    // Resolución dinámica (solo la usa render())
+    sf::RenderTexture sceneTarget;
+    float renderBudget = 0.f;  // segundos por frame; 0 = dibujar directo a la ventana
+    float renderScale = 1.f;   // fracción de los píxeles usada en cada eje
+    float renderSeconds = 0.f; // tiempo de dibujo suavizado
+    int scaleFrames = 0;
+    // Efectos visuales; solo presentación, la simulación no los ve
+    ParticleSystem particles;
+    sf::VertexArray particleVertices{sf::Triangles};
+    unsigned drawCalls = 0;      // del frame en curso
+    unsigned lastDrawCalls = 0;  // del frame anterior, para mostrar
+    bool showDebug = false;      // F3: perfilador, llamadas de dibujo y entidades
+
+    // Tiempos por zona de cada frame (ver Profiler.hpp)
+    Profiler profiler;
+    std::string profileOutput;
+    float profileRefresh = 0.f;  // la tabla del overlay se rehace 4 veces por segundo
+    std::string profileText;
+
+    // Repeticiones (ver Replay.hpp)
+    std::string recordPath;
+    Replay recording;
+    bool recordingGame = false; // la partida en curso empezó con startGame(): se graba
+    Replay playback;
+    bool replaying = false;
+    size_t playbackTick = 0;
+    float replaySpeed = 1.f;
+    // Rebobinado (mantener Retroceso) y partida guardada (ver RewindBuffer.hpp y WorldState.hpp)
+    RewindBuffer rewind;
+    std::string sessionPath = "partida.sav";
+    std::future<bool> sessionSaving; // escritura en curso
+    // Piloto automático y prueba de resistencia
+    bool autopilot = false;
+    bool soaking = false;
+    bool soakOk = true;
+    unsigned soakGames = 0;
+    SoakLimits soakLimits;
+    SoakMonitor soak;
+    // Semillas de las partidas y elección de canciones; la simulación usa el Rng de World
+    Rng sessionRng;
 
-    int score = 0;
-    int maxScore = 0;
-    int lives = 3;
-    float timeSinceLastShot = 0.f;
-    float asteroidTimer = 0.f;
-    // Registra el tiempo total de juego (segundos) para aumentar la dificultad con el tiempo
-    float elapsedTime = 0.f;
     
     // Sistema de música
-    // Sistema de música
-    std::vector<std::string> musicPaths;
-    std::vector<std::unique_ptr<sf::Music>> musicTracks;
-    int currentTrackIndex = -1;
+    MusicPlayer music;
     float musicVolume = 50.f; // 0-100
-    float musicFadeTimer = 0.f;
     
     // Sonido de disparo
     sf::SoundBuffer shootSoundBuffer;
-    sf::Sound shootSound;
     // Sonido de explosión de asteroide
     sf::SoundBuffer explosionSoundBuffer;
-    sf::Sound explosionSound;
-    
-    // Barra de volumen - propiedades para interacción con mouse
-    sf::FloatRect volumeBarRect;
-    // Botones de control de música (anterior / reproducir/pausa / siguiente)
-    sf::FloatRect prevButtonRect;
-    sf::FloatRect playPauseButtonRect;
-    sf::FloatRect nextButtonRect;
+    // Voces compartidas por los efectos (ver SfxPool.hpp)
+    SfxPool sfx;
 };
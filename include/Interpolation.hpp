@@ -0,0 +1,14 @@
+#pragma once
+#include <SFML/System.hpp>
+#include <cmath>
+
+// Un salto mayor que esto entre dos ticks solo puede ser un envolvimiento de
+// pantalla (wrap-around); en ese caso no se interpola para no cruzar la pantalla.
+const float MAX_INTERP_JUMP = 360.f;
+
+// Posición para dibujar entre el tick anterior (`prev`) y el actual (`cur`), alpha en [0,1].
+inline sf::Vector2f interpolatePosition(const sf::Vector2f& prev, const sf::Vector2f& cur, float alpha) {
+    sf::Vector2f d = cur - prev;
+    if (std::fabs(d.x) > MAX_INTERP_JUMP || std::fabs(d.y) > MAX_INTERP_JUMP) return cur;
+    return prev + d * alpha;
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Sistema de trabajos pequeño para repartir bucles entre núcleos. Cada hilo
+// tiene su propia cola (deque): saca trabajo del final de la suya y, cuando se
+// le acaba, roba del principio de la de otro. El hilo que llama a
+// parallelFor() también trabaja y no vuelve hasta que termina todo el bucle.
+//
+// Pensado para un solo productor (el hilo de la simulación): no se llama a
+// parallelFor() desde dentro de un trabajo.
+class JobSystem {
+public:
+    // `workers` hilos además del que llama; 0 = uno por núcleo menos el que llama.
+    explicit JobSystem(unsigned workers = 0);
+    ~JobSystem();
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // Hilos que ejecutan trabajos, contando al que llama; `slot` va de 0 a esto - 1.
+    unsigned concurrency() const { return (unsigned)queues.size(); }
+
+    // Corre fn(begin, end, slot) sobre [0, count) en trozos de `grain`
+    // elementos. Los trozos empiezan en múltiplos de `grain`, así cada uno sabe
+    // su índice (begin / grain) para escribir resultados sin compartir nada.
+    template <class F>
+    void parallelFor(size_t count, size_t grain, F&& fn) {
+        if (count == 0) return;
+        if (grain == 0) grain = 1;
+        if (queues.size() == 1 || count <= grain) {
+            for (size_t b = 0; b < count; b += grain) fn(b, b + grain < count ? b + grain : count, 0u);
+            return;
+        }
+        using Fn = typename std::remove_reference<F>::type;
+        run(count, grain, &invoke<Fn>, (void*)&fn);
+    }
+
+private:
+    using RangeFn = void (*)(void* ctx, size_t begin, size_t end, unsigned slot);
+    template <class Fn>
+    static void invoke(void* ctx, size_t begin, size_t end, unsigned slot) {
+        (*static_cast<Fn*>(ctx))(begin, end, slot);
+    }
+
+    struct Task {
+        RangeFn fn;
+        void* ctx;
+        size_t begin, end;
+    };
+
+    // Cola de un hilo: el dueño saca del final (lo último que puso, aún en
+    // caché) y los ladrones del principio. Un mutex por cola basta: se toca
+    // una vez por trozo, no por elemento.
+    struct WorkQueue {
+        std::mutex mutex;
+        std::vector<Task> tasks;
+        size_t head = 0;
+        void push(const Task& t);
+        bool pop(Task& t);
+        bool steal(Task& t);
+    };
+
+    void run(size_t count, size_t grain, RangeFn fn, void* ctx);
+    bool runOne(unsigned slot);
+    void workerLoop(unsigned slot);
+
+    std::vector<std::unique_ptr<WorkQueue>> queues; // [0] es la del hilo que llama
+    std::vector<std::thread> threads;
+    std::atomic<size_t> pending{0};
+
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    unsigned generation = 0;
+    bool stopping = false;
+};
@@ -0,0 +1,66 @@
+#pragma once
+#include <SFML/Audio.hpp>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Random.hpp"
+#include "AssetPack.hpp"
+
+// Reproductor de la música de fondo. Solo tiene abiertas la pista que suena y
+// la siguiente: la siguiente se abre en un hilo de fondo unos segundos antes
+// de que acabe la actual y entra con un fundido cruzado, así cambiar de pista
+// no bloquea el frame ni deja siete archivos abiertos.
+class MusicPlayer {
+public:
+    // Pistas disponibles; las que no se puedan abrir se saltan.
+    void setTracks(std::vector<std::string> paths);
+    void seed(std::uint64_t s) { rng.seed(s); }
+    // Las pistas que estén en el paquete se leen de su mapeo en lugar del disco.
+    void setPack(const AssetPack* p) { pack = p; }
+    // Empieza con una pista al azar (se abre en segundo plano).
+    void start();
+    // Lleva la apertura anticipada y el fundido; una vez por frame.
+    void update(float dt);
+
+    void next();
+    void prev();
+    void togglePause();
+    void setVolume(float volume); // 0-100
+    bool isPlaying() const;
+
+private:
+    using Stream = std::unique_ptr<sf::Music>;
+
+    // Recoge la apertura terminada y lanza la de la pista pedida.
+    void pump();
+    // Índice al azar distinto del actual, sin las pistas que fallaron (-1 si no queda ninguna).
+    int randomNext();
+    // Vecina de la actual en la lista, saltando las que fallaron.
+    int neighbour(int step);
+    void skipTo(int index);
+    void beginCrossfade(float seconds);
+    void finishCrossfade();
+    void applyVolumes();
+
+    std::vector<std::string> paths;
+    std::vector<bool> broken;
+    Rng rng;
+    const AssetPack* pack = nullptr;
+    float volume = 50.f;
+    bool paused = false;
+
+    Stream current;              // la que suena
+    int currentIndex = -1;
+    Stream incoming;             // entrando con el fundido
+    int incomingIndex = -1;
+    float fade = 0.f;            // segundos de fundido transcurridos
+    float fadeLength = 1.f;
+
+    Stream prefetched;           // abierta y lista para sonar
+    int prefetchedIndex = -1;
+    std::future<Stream> opening; // apertura en curso
+    int openingIndex = -1;
+    int wantedIndex = -1;        // la que sonará después (-1 = aún no elegida)
+    bool skipRequested = false;  // pasar a wantedIndex en cuanto esté abierta
+};
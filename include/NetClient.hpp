@@ -0,0 +1,80 @@
+#pragma once
+#include <SFML/Network.hpp>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "NetProtocol.hpp"
+
+class World;
+
+// Cliente de una partida en red: manda la entrada de cada tick al anfitrión
+// (NetServer) y convierte sus instantáneas en un World que Game dibuja y hace
+// sonar igual que uno local, pero que nunca llama step():
+//
+// - asteroides, balas y las demás naves se muestran un poco en el pasado,
+//   interpolando entre las dos instantáneas que rodean ese momento;
+// - la nave propia se predice: la última posición autoritativa más las
+//   entradas que el servidor aún no aplicó, con el mismo Ship::handleInput y
+//   Ship::update que la simulación;
+// - las explosiones, disparos y destrucciones del tick se deducen de lo que
+//   desapareció, apareció o murió entre una muestra y la siguiente.
+class NetClient {
+public:
+    ~NetClient() { disconnect(); }
+
+    // Abre un socket local y empieza a saludar a `host`:`port`.
+    bool connect(const std::string& host, unsigned short port, float tickRate);
+    // Avisa al servidor (Bye) y cierra.
+    void disconnect();
+    // Un tick del cliente: manda `input`, lee lo que llegó y deja en `world`
+    // lo que hay que mostrar.
+    void update(World& world, const ShipInput& input);
+
+    // Llegó al menos una instantánea.
+    bool connected() const { return latest != 0; }
+    // Pasaron unos segundos sin noticias del servidor.
+    bool timedOut() const;
+    const NetStats& stats() const { return netStats; }
+    std::string describe() const;
+
+private:
+    static const size_t HISTORY = 32;     // instantáneas recibidas, en tick % HISTORY
+    static const size_t INPUT_HISTORY = 256;
+
+    void sendPacket();
+    void receive();
+    void handleSnapshot(const std::uint8_t* data, size_t size);
+    // Muestra interpolada de las instantáneas en el tick `at` del servidor.
+    bool sample(float at, NetState& out) const;
+    // Rellena `world` con la muestra y la nave predicha, y anota los eventos.
+    void present(World& world, const NetState& shown, float dt);
+
+    sf::UdpSocket socket;
+    sf::IpAddress server;
+    unsigned short serverPort = 0;
+    bool open = false;
+    float tickRate = 60.f;
+
+    std::vector<NetState> snapshots;      // decodificadas (tick 0 = hueco)
+    std::uint32_t latest = 0;             // tick de la más nueva
+    std::uint32_t snapshotGap = 0;        // ticks entre las dos últimas
+    std::uint32_t serverHz = 60;
+    std::uint8_t myId = 0;
+    std::uint32_t ackedInput = 0;         // el servidor aplicó las entradas anteriores a esta
+    float ticksSinceLatest = 0.f;         // ticks locales desde la más nueva
+    std::chrono::steady_clock::time_point heardAt;
+
+    std::vector<std::uint8_t> inputs;     // por secuencia, en seq % INPUT_HISTORY
+    std::uint32_t inputSeq = 0;           // la próxima por enviar
+
+    // Lo mostrado en el tick anterior, para deducir los eventos.
+    NetState shown;
+    bool hasShown = false;
+    NetState current;                     // la muestra de este tick
+    NetState scratch;                     // destino de la decodificación
+    unsigned helloCountdown = 0;
+    std::vector<std::uint8_t> buffer;
+    NetWriter packet;
+    NetStats netStats;
+};
@@ -0,0 +1,135 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Ship.hpp"
+
+class World;
+
+// Protocolo del modo en red sobre UDP (ver NetServer y NetClient).
+//
+// Cliente -> servidor:
+//   Hello:  tipo u8, protocolo u32                              (hasta recibir instantáneas)
+//   Input:  tipo u8, última instantánea recibida u32, hora del cliente u32 (ms),
+//           rtt u16 (ms), secuencia de la primera entrada u32, n u8, n entradas
+//           (bits de Replay::packInput; se repiten las últimas por si se pierde un paquete)
+//   Bye:    tipo u8
+// Servidor -> cliente:
+//   Snapshot: tipo u8, tick u32, tick de la base u32 (0 = completa), ticks/s u16,
+//             id de tu nave u8, última entrada aplicada u32, eco de la hora
+//             del cliente u32, ms retenida en el servidor u16, y el cuerpo de
+//             encodeSnapshot().
+//
+// El cuerpo va cuantizado (posiciones a 1/16 px, velocidades a 1/4 px/s) y en
+// delta contra la última instantánea que el cliente confirmó: de cada
+// asteroide o bala solo viaja lo que no coincide con lo que el cliente puede
+// predecir por su cuenta (la base movida en línea recta hasta este tick, con
+// aritmética entera para que servidor y cliente den lo mismo bit a bit).
+// Como se mueven en línea recta, casi nada viaja una vez que se vio nacer.
+const std::uint32_t NET_PROTOCOL = 0x41535431; // "AST1"
+enum class NetPacket : std::uint8_t { Hello = 1, Input = 2, Bye = 3, Snapshot = 4 };
+// Entradas repetidas en cada paquete de entrada.
+const unsigned NET_INPUT_REDUNDANCY = 8;
+// Lo más que cabe en un datagrama UDP; una instantánea mayor no se envía.
+const size_t NET_MAX_DATAGRAM = 65507;
+// BulletStore::wrapMargin, para predecir el envolvimiento de las balas.
+const float NET_BULLET_MARGIN = 10.f;
+
+// Enteros little-endian y varints (7 bits por byte) sobre un búfer.
+struct NetWriter {
+    std::vector<std::uint8_t> bytes;
+    void u8(std::uint32_t v);
+    void u16(std::uint32_t v);
+    void u32(std::uint32_t v);
+    void varint(std::uint32_t v);
+};
+
+// Lectura con límites: cualquier lectura fuera del paquete deja ok = false y devuelve 0.
+struct NetReader {
+    const std::uint8_t* data = nullptr;
+    size_t size = 0;
+    size_t pos = 0;
+    bool ok = true;
+    NetReader(const void* d, size_t n) : data((const std::uint8_t*)d), size(n) {}
+    std::uint32_t u8();
+    std::uint32_t u16();
+    std::uint32_t u32();
+    std::uint32_t varint();
+};
+
+// Asteroide o bala cuantizado; la clave es (slot, generación) del pool.
+struct NetEntity {
+    std::uint16_t slot = 0;
+    std::uint8_t generation = 0;
+    std::uint16_t x = 0, y = 0;
+    std::int16_t vx = 0, vy = 0;
+    std::uint8_t radius = 0; // 1/4 px
+    std::int8_t size = 0;
+};
+
+struct NetShip {
+    std::uint8_t id = 0;      // 0 = la nave del anfitrión
+    std::uint8_t deaths = 0;
+    bool alive = false, thrusting = false;
+    std::uint16_t x = 0, y = 0;
+    std::int16_t vx = 0, vy = 0;
+    std::uint16_t angle = 0;  // 65536 = 360 grados
+};
+
+// Lo que ve un cliente en un tick: naves, asteroides y balas (ordenados por slot) y el HUD.
+struct NetState {
+    std::uint32_t tick = 0;
+    std::int32_t score = 0;
+    std::int8_t lives = 0;
+    std::vector<NetShip> ships;
+    std::vector<NetEntity> asteroids, bullets;
+
+    void capture(const World& world, std::uint32_t tick);
+};
+
+std::uint16_t quantizePosition(float p);
+float dequantizePosition(std::uint16_t q);
+std::int16_t quantizeVelocity(float v);
+float dequantizeVelocity(std::int16_t q);
+NetShip quantizeShip(const Ship& ship, std::uint8_t id);
+// Pone en `ship` lo recibido (posición, velocidad, ángulo y estado); la
+// posición y el ángulo anteriores quedan iguales a los nuevos.
+void applyShip(const NetShip& q, Ship& ship);
+// Posición de una entidad `ticks` ticks después, en línea recta y envolviendo
+// como la simulación (aritmética entera: la misma en servidor y cliente).
+void predictEntity(const NetEntity& e, std::uint32_t ticks, std::uint32_t tickHz, float margin,
+                   std::uint16_t& x, std::uint16_t& y);
+
+// Escribe `state` en delta contra `baseline` (nullptr = completa) y deja en
+// `sent` lo que el cliente reconstruirá: la próxima base debe ser eso y no
+// `state`, porque lo que no viajó queda con el valor predicho.
+void encodeSnapshot(NetWriter& out, const NetState& state, const NetState* baseline,
+                    std::uint32_t tickHz, NetState& sent);
+// Inverso de encodeSnapshot; `state.tick` ya debe estar puesto. false si el paquete está mal.
+bool decodeSnapshot(NetReader& in, NetState& state, const NetState* baseline, std::uint32_t tickHz);
+
+// Contadores de una conexión: totales, bytes por segundo del último segundo y latencia.
+struct NetStats {
+    std::uint64_t bytesSent = 0, bytesReceived = 0;
+    std::uint32_t packetsSent = 0, packetsReceived = 0;
+    float sendRate = 0.f, receiveRate = 0.f; // bytes/s
+    float rttMs = 0.f;                       // ida y vuelta, suavizado
+    std::uint32_t lastSnapshotBytes = 0;
+    std::uint32_t oversized = 0;             // instantáneas que no cupieron en un datagrama
+
+    void sent(size_t bytes);
+    void received(size_t bytes);
+    // Cierra la ventana de un segundo cuando toca.
+    void update(std::chrono::steady_clock::time_point now);
+    void addRttSample(float ms);
+    std::string describe() const;
+
+private:
+    std::uint64_t windowSent = 0, windowReceived = 0;
+    std::chrono::steady_clock::time_point windowStart{};
+};
+
+// Milisegundos de un reloj monótono (para los ecos de latencia; da la vuelta cada 49 días).
+std::uint32_t netMillis();
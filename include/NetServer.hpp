@@ -0,0 +1,75 @@
+#pragma once
+#include <SFML/Network.hpp>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+#include "NetProtocol.hpp"
+
+class World;
+
+// Anfitrión de una partida en red: la simulación autoritativa es el World de
+// quien hospeda y cada cliente conectado maneja una de sus naves invitadas
+// (World::Guest). Un socket UDP sin bloqueo; todo ocurre en el hilo de la
+// simulación, alrededor de cada World::step():
+//
+//   server.receive(world);    // entradas de los clientes para este tick
+//   world.step(dt, input);
+//   server.send(world);       // instantánea cuando toca
+//
+// Cada cliente recibe instantáneas a `snapshotRate` por segundo, en delta
+// contra la última que confirmó (ver NetProtocol.hpp).
+class NetServer {
+public:
+    // Abre el puerto; false si no se pudo. `tickRate`: ticks por segundo de la simulación.
+    bool start(unsigned short port, float tickRate, float snapshotRate);
+    void stop();
+    bool running() const { return open; }
+    unsigned short port() const { return socket.getLocalPort(); }
+
+    // Lee los paquetes pendientes (altas, entradas, bajas, clientes que dejaron
+    // de responder) y pone en cada invitado la entrada que le toca a este tick.
+    void receive(World& world);
+    // Cuenta el tick recién simulado y manda la instantánea si toca.
+    void send(const World& world);
+
+    size_t clientCount() const { return clients.size(); }
+    // Una línea por cliente: id, dirección y NetStats::describe().
+    std::string describe() const;
+
+private:
+    // Instantáneas enviadas que pueden servir de base (la confirmada suele tener pocos ticks).
+    static const size_t HISTORY = 32;
+
+    struct Client {
+        sf::IpAddress address;
+        unsigned short port = 0;
+        std::uint8_t id = 0;
+        // Entradas recibidas a partir de la secuencia nextInput (la próxima a aplicar).
+        std::deque<std::uint8_t> inputs;
+        std::uint32_t nextInput = 0;
+        std::uint8_t lastInput = 0;   // se repite si la siguiente no llegó a tiempo
+        std::uint32_t ackedTick = 0;  // última instantánea que confirmó
+        std::uint32_t clientMs = 0;   // hora del cliente en su último paquete, para el eco
+        std::chrono::steady_clock::time_point heardAt;
+        std::vector<NetState> history; // lo enviado en cada tick, en tick % HISTORY
+        NetStats stats;
+    };
+
+    Client* find(const sf::IpAddress& address, unsigned short port);
+    void handlePacket(World& world, const std::uint8_t* data, size_t size,
+                      const sf::IpAddress& address, unsigned short port);
+    void addClient(World& world, const sf::IpAddress& address, unsigned short port);
+    void removeClient(World& world, size_t index);
+
+    sf::UdpSocket socket;
+    bool open = false;
+    std::uint32_t tickHz = 60;
+    std::uint32_t snapshotInterval = 3; // ticks entre instantáneas
+    std::uint32_t tick = 0;
+    std::vector<Client> clients;
+    NetState state;                     // captura compartida por todos los clientes
+    NetWriter packet;
+    std::vector<std::uint8_t> buffer;
+};
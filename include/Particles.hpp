@@ -0,0 +1,53 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+#include "Random.hpp"
+
+// Partículas de los efectos (restos de asteroides, estela del motor, explosión
+// de la nave). Solo son visuales: viven en Game, no en World, así no cambian
+// la simulación ni las repeticiones.
+//
+// Arreglos SoA con las vivas al principio (una muerta se cambia por la última),
+// así update() es un bucle corrido sobre [0, live()) y draw() arma todos los
+// quads en un solo sf::VertexArray y hace una llamada de dibujo.
+class ParticleSystem {
+public:
+    // Parámetros de una ráfaga: dirección en grados (angle ± spread), rapidez,
+    // vida en segundos, lado del cuadrado en píxeles y color inicial.
+    struct Burst {
+        sf::Vector2f origin;
+        sf::Vector2f baseVelocity; // se suma a cada partícula (la del objeto que explota)
+        float angle = 0.f, spread = 180.f;
+        float minSpeed = 50.f, maxSpeed = 150.f;
+        float minLife = 0.5f, maxLife = 1.f;
+        float size = 2.f;
+        sf::Color color = sf::Color::White;
+    };
+
+    // Capacidad fija: con el arreglo lleno, las partículas nuevas se descartan.
+    void init(size_t capacity);
+    void clear();
+    void emit(const Burst& burst, unsigned count);
+    // Avanza posiciones, frena y quita las que se agotaron.
+    void update(float dt);
+
+    size_t live() const { return x.size(); }
+    size_t capacity() const { return max; }
+    // Copia solo las vivas (instantáneas para el hilo de dibujo).
+    void copyFrom(const ParticleSystem& other);
+
+    // Dibuja todas en una llamada, `rewind` segundos antes de su posición
+    // actual (interpolación entre ticks). `vertices` se reutiliza entre frames.
+    unsigned draw(sf::RenderTarget& target, sf::VertexArray& vertices, float rewind) const;
+    // Solo arma los quads (6 vértices por partícula), sin dibujar.
+    void buildVertices(sf::VertexArray& vertices, float rewind) const;
+
+private:
+    std::vector<float> x, y, vx, vy;
+    std::vector<float> life, invLife; // segundos que quedan y 1 / vida inicial
+    std::vector<float> size;
+    std::vector<sf::Color> color;
+    size_t max = 0;
+    Rng rng;
+};
@@ -0,0 +1,94 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Zonas medidas. Las anidadas (Input dentro de Update, etc.) se cuentan
+// también en la zona que las contiene.
+enum class ProfileZone : int {
+    Frame,
+    Events,
+    Update, Input, Integration, Collision, Spawning, Music,
+    Render, Background, Entities, Hud,
+    Count
+};
+const char* profileZoneName(ProfileZone zone);
+
+// Perfilador de frames: suma el tiempo de cada zona dentro del frame y guarda
+// los últimos `window` frames para sacar mínimo, media y p99. Con grabación
+// activa además guarda cada frame y cada zona para volcarlos al salir en CSV
+// (un frame por fila) o en JSON de eventos de Chrome (chrome://tracing, Perfetto).
+class Profiler {
+public:
+    using Clock = std::chrono::steady_clock;
+    static const size_t ZONE_COUNT = (size_t)ProfileZone::Count;
+
+    struct Stats {
+        double minMs = 0.0, avgMs = 0.0, p99Ms = 0.0;
+    };
+
+    explicit Profiler(size_t window = 240);
+
+    void beginFrame();
+    void endFrame();
+    // Lo llama ProfileScope al cerrar la zona.
+    void add(ProfileZone zone, Clock::time_point start, Clock::time_point end);
+
+    // Estadísticas de la zona en la ventana de frames recientes.
+    Stats stats(ProfileZone zone) const;
+    size_t frames() const { return filled; }
+    // Tabla de texto con min/media/p99 por zona, para el overlay o la consola.
+    std::string table() const;
+
+    // Marca el primer frame interactivo: el arranque se mide desde que se creó el perfilador.
+    void markStartup();
+    double startupMs() const { return startup; }
+
+    // Guarda todo lo medido desde ahora (la memoria se pide aquí, no por frame).
+    void setRecording(bool enabled);
+    // Escribe lo grabado: JSON de eventos si `path` termina en .json, CSV si no.
+    bool write(const std::string& path) const;
+    bool writeCsv(const std::string& path) const;
+    bool writeTrace(const std::string& path) const;
+
+private:
+    struct TraceEvent {
+        std::uint8_t zone;
+        float durationUs;
+        double startUs; // desde el inicio del perfilador
+    };
+
+    const size_t window;
+    std::vector<float> history;   // window x ZONE_COUNT, en ms
+    size_t head = 0, filled = 0;
+    std::array<double, ZONE_COUNT> current{};
+    Clock::time_point origin;
+    Clock::time_point frameStart;
+    mutable std::vector<float> scratch;
+    double startup = 0.0;
+
+    bool recording = false;
+    std::vector<TraceEvent> events;
+    std::vector<float> frameLog;  // un bloque de ZONE_COUNT por frame grabado
+};
+
+// Mide el bloque en que vive. Con `profiler` nulo no hace nada, así la
+// simulación se puede usar sin perfilador (headless, benchmarks).
+class ProfileScope {
+public:
+    ProfileScope(Profiler* p, ProfileZone z) : profiler(p), zone(z) {
+        if (profiler) start = Profiler::Clock::now();
+    }
+    ~ProfileScope() {
+        if (profiler) profiler->add(zone, start, Profiler::Clock::now());
+    }
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    Profiler* profiler;
+    ProfileZone zone;
+    Profiler::Clock::time_point start;
+};
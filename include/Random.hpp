@@ -0,0 +1,53 @@
+#pragma once
+#include <cstdint>
+
+// Generador pseudoaleatorio rápido y determinista (xoshiro128**). Con la misma
+// semilla da la misma secuencia en cualquier plataforma, a diferencia de
+// std::rand, y cada partida tiene el suyo en lugar de un estado global.
+class Rng {
+public:
+    explicit Rng(std::uint64_t s = 1) { seed(s); }
+
+    // Expande la semilla a los 128 bits de estado con splitmix64.
+    void seed(std::uint64_t s) {
+        for (int i = 0; i < 4; i += 2) {
+            s += 0x9E3779B97F4A7C15ull;
+            std::uint64_t z = s;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            z ^= z >> 31;
+            state[i] = (std::uint32_t)z;
+            state[i+1] = (std::uint32_t)(z >> 32);
+        }
+    }
+
+    std::uint32_t next() {
+        const std::uint32_t result = rotl(state[1] * 5, 7) * 9;
+        const std::uint32_t t = state[1] << 9;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 11);
+        return result;
+    }
+
+    // Entero en [0, n), sin la división de rand() % n.
+    std::uint32_t below(std::uint32_t n) {
+        return (std::uint32_t)(((std::uint64_t)next() * n) >> 32);
+    }
+
+    // Flotante en [lo, hi).
+    float uniform(float lo, float hi) {
+        return lo + (hi - lo) * ((next() >> 8) * (1.f / 16777216.f));
+    }
+
+    // Los 128 bits de estado, para guardar y retomar la secuencia (ver WorldState).
+    void getState(std::uint32_t out[4]) const { for (int i = 0; i < 4; ++i) out[i] = state[i]; }
+    void setState(const std::uint32_t in[4]) { for (int i = 0; i < 4; ++i) state[i] = in[i]; }
+
+private:
+    static std::uint32_t rotl(std::uint32_t x, int k) { return (x << k) | (x >> (32 - k)); }
+    std::uint32_t state[4];
+};
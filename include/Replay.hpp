@@ -0,0 +1,33 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Ship.hpp"
+
+// Repetición de una partida: la semilla de World, el dt fijo y la entrada de
+// cada tick. Con eso World::step reproduce la partida bit a bit (mismo
+// binario), así que sirve para repetir un pico de rendimiento o para comprobar
+// que una optimización no cambió el juego (finalChecksum = World::checksum()).
+//
+// En memoria es un byte por tick; en disco los ticks iguales seguidos se
+// guardan juntos (byte de botones + cuántos ticks, varint), unos pocos KB por
+// partida. Formato: "ASTR", versión u32, semilla u64, dt f32, ticks u32,
+// huella final u64 y los tramos; enteros en little-endian.
+struct Replay {
+    std::uint64_t seed = 0;
+    float dt = 1.f/60.f;
+    std::uint64_t finalChecksum = 0;
+    std::vector<std::uint8_t> inputs; // un byte por tick (packInput)
+
+    // Empieza una grabación vacía; reserva para una hora a 60 Hz.
+    void begin(std::uint64_t s, float tickDt);
+    void record(const ShipInput& in) { inputs.push_back(packInput(in)); }
+    size_t ticks() const { return inputs.size(); }
+    ShipInput input(size_t tick) const { return unpackInput(inputs[tick]); }
+
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+
+    static std::uint8_t packInput(const ShipInput& in);
+    static ShipInput unpackInput(std::uint8_t bits);
+};
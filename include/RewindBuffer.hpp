@@ -0,0 +1,64 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "WorldState.hpp"
+
+class World;
+
+// Anillo de los últimos estados de la partida para rebobinar al instante.
+// Cada `interval` ticks guarda un WorldState; uno de cada `keyframeEvery` va
+// entero y los demás como delta contra el anterior: XOR byte a byte (el
+// formato deja cada slot y cada plano de bytes en su sitio salvo cuando un
+// pool cruza un bloque de 16 slots, ver WorldState.hpp) y las rachas de ceros
+// resumidas en varints. Lo que queda son los bytes que de verdad cambiaron
+// (sobre todo los bajos de posiciones y velocidades): unos cientos de bytes
+// en una partida normal. Restaurar uno cuesta aplicar como mucho
+// keyframeEvery - 1 deltas.
+//
+// Uso en el bucle: reset(world) al empezar la partida y record(world) después
+// de cada World::step().
+class RewindBuffer {
+public:
+    // `capacity` estados, uno cada `interval` ticks: capacity * interval ticks hacia atrás.
+    void configure(unsigned interval, size_t capacity, unsigned keyframeEvery = 8);
+    // Vacía el anillo y guarda `world` como el tick 0.
+    void reset(const World& world);
+    // Cuenta un tick y guarda el estado si toca.
+    void record(const World& world);
+    // Vuelve al estado guardado más reciente con al menos `ticks` ticks de
+    // antigüedad (o al más viejo que haya) y olvida los posteriores. Devuelve
+    // el tick restaurado (los ticks desde reset()), o -1 si no hay ninguno.
+    long long rewind(World& world, size_t ticks);
+
+    std::uint64_t tick() const { return now; }
+    size_t count() const { return used; }
+    // Bytes guardados en el anillo (deltas y estados enteros).
+    size_t storedBytes() const;
+    // Tamaño medio de los deltas guardados (0 si solo hay estados enteros).
+    size_t averageDeltaBytes() const;
+    // Segundos que se pueden rebobinar con `tickDt` por tick.
+    float secondsAvailable(float tickDt) const;
+
+private:
+    struct Entry {
+        std::uint64_t tick = 0;
+        bool keyframe = true;
+        std::vector<std::uint8_t> data; // estado entero o delta contra la entrada anterior
+    };
+    Entry& at(size_t i) { return entries[(first + i) % entries.size()]; }
+    const Entry& at(size_t i) const { return entries[(first + i) % entries.size()]; }
+    // Reconstruye en `out` el estado de la entrada `i` (0 = la más vieja).
+    void decode(size_t i, std::vector<std::uint8_t>& out) const;
+    void push(const World& world);
+
+    std::vector<Entry> entries;
+    size_t first = 0, used = 0;
+    unsigned interval = 6;
+    unsigned keyframeEvery = 8;
+    unsigned sinceKeyframe = 0;
+    std::uint64_t now = 0;
+    WorldState current;             // el último estado guardado, entero: base del próximo delta
+    WorldState scratch;
+    std::vector<std::uint8_t> promoted; // delta que pasa a estado entero (se reutiliza)
+};
@@ -0,0 +1,56 @@
+#pragma once
+#include <SFML/Audio.hpp>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// Efectos de sonido del juego. El valor es el índice del arreglo.
+enum class Sfx : unsigned { Shoot, Explosion, Count };
+
+// Voces compartidas por todos los efectos: un número fijo de sf::Sound que se
+// reutilizan. Los disparos de un tick se juntan en uno solo (más fuerte si
+// fueron varios), cada efecto tiene un tope de voces a la vez y, si no queda
+// ninguna libre, se roba la de menor prioridad y más antigua.
+//
+// Uso: configure() por efecto, trigger() durante el tick, flush() al final.
+class SfxPool {
+public:
+    explicit SfxPool(size_t voices = 16);
+
+    // `gain` relativo al volumen general; sin buffer el efecto no suena.
+    void configure(Sfx id, const sf::SoundBuffer* buffer, float gain, int priority, unsigned maxInstances);
+    void setVolume(float volume); // 0-100
+    // Se acumula hasta flush(): varias veces en el mismo tick suenan como una.
+    void trigger(Sfx id, unsigned count = 1) { pending[(size_t)id] += count; }
+    // Hace sonar lo pedido desde el último flush().
+    void flush();
+
+    // Voces sonando ahora (para depuración).
+    unsigned activeVoices() const;
+
+private:
+    static const size_t SFX_COUNT = (size_t)Sfx::Count;
+    static const unsigned NO_EFFECT = ~0u;
+
+    struct Effect {
+        const sf::SoundBuffer* buffer = nullptr;
+        float gain = 1.f;
+        int priority = 0;
+        unsigned maxInstances = 1;
+    };
+    struct Voice {
+        sf::Sound sound;
+        unsigned effect = NO_EFFECT;
+        std::uint64_t started = 0; // orden de arranque, para robar la más antigua
+    };
+
+    // Voz para `id`, o -1 si todas tienen más prioridad.
+    int pickVoice(Sfx id);
+    void play(Sfx id, unsigned count);
+
+    std::vector<Voice> voices;
+    std::array<Effect, SFX_COUNT> effects;
+    std::array<unsigned, SFX_COUNT> pending{};
+    std::uint64_t playCount = 0;
+    float volume = 100.f;
+};
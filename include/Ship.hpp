@@ -1,26 +1,44 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include <cstdint>
 #include "Bullet.hpp"
+#include "SpriteBatch.hpp"
+
+// Estado de los controles de la nave en un tick. Se llena desde el teclado en
+// `Game` o desde un guion en el modo headless.
+struct ShipInput {
+    bool left = false;
+    bool right = false;
+    bool thrust = false;
+    bool shoot = false;
+};
 
 // Nave del jugador. Mantiene forma/textura y física sencilla.
 class Ship {
 public:
     Ship();
     void update(float dt);
-    void handleInput();
-    void draw(sf::RenderTarget& target) const;
+    void handleInput(const ShipInput& input, float dt);
+    // `alpha` indica cuánto se avanzó entre el tick anterior y el actual.
+    void draw(SpriteBatch& batch, float alpha = 1.f) const;
     Bullet shoot();
     void reset(const sf::Vector2f& pos);
 
     sf::Vector2f position;
     sf::Vector2f velocity;
     float angle = -90.f; // arriba
+    // estado del tick anterior, para interpolar al dibujar
+    sf::Vector2f prevPosition;
+    float prevAngle = -90.f;
     float radius = 16.f;
 
-    const sf::Texture* texture = nullptr; // textura opcional
+    SpriteRegion sprite; // imagen en el atlas (opcional)
     bool alive = true;
+    bool thrusting = false; // empujando en el último tick (para la estela del motor)
+    std::uint8_t deaths = 0; // veces destruida (reset() no lo toca): los clientes en red ven la explosión
 private:
-    float thrust = 200.f;
+    friend struct WorldState; // guarda y restaura timeSinceShot
+    float thrust = 400.f; // aceleración en px/s²
     float rotationSpeed = 180.f; // grados por segundo
     float shootCooldown = 0.2f;
     float timeSinceShot = 0.f;
@@ -0,0 +1,22 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Núcleos de actualización sobre arreglos (SoA). Usan AVX o SSE2 si el
+// compilador los habilita (-mavx / -march=native) y una versión escalar si no.
+
+// Integra x += vx*dt, y += vy*dt y envuelve con margen por entidad:
+// si x < -m pasa a W+m, si x > W+m pasa a -m (igual en y con H).
+void integrateWrap(float* x, float* y, const float* vx, const float* vy,
+                   const float* margin, std::size_t n, float dt, float width, float height);
+
+// Igual que integrateWrap pero con el mismo margen para todas las entidades.
+void integrateWrapUniform(float* x, float* y, const float* vx, const float* vy,
+                          float margin, std::size_t n, float dt, float width, float height);
+
+// lifetime -= dt; las entidades vivas cuyo tiempo llega a 0 quedan con
+// alive = 0 y su índice se escribe en `expired`. Devuelve cuántas fueron.
+std::size_t tickLifetimes(float* lifetime, std::uint8_t* alive, std::size_t n, float dt, std::uint32_t* expired);
+
+// Nombre del conjunto de instrucciones compilado ("avx", "sse2" o "escalar").
+const char* simdPathName();
@@ -0,0 +1,58 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+class World;
+
+// Límites de la prueba de resistencia (--soak).
+struct SoakLimits {
+    float duration = 600.f;        // segundos de reloj
+    float interval = 10.f;         // entre muestras
+    double maxRssGrowthMB = 16.0;  // crecimiento de la memoria residente tolerado
+    double maxTickDrift = 0.25;    // 0.25 = la mediana del tick puede subir un 25 %
+};
+
+// Prueba de resistencia: mientras el piloto automático juega partida tras
+// partida, cada `interval` segundos anota una muestra (memoria residente,
+// entidades vivas, partidas y los percentiles de los ticks y frames del
+// intervalo) e imprime una línea. Al final compara el principio con el final:
+// falla si la RSS creció más de maxRssGrowthMB o si la mediana del tick subió
+// más de maxTickDrift. El primer 10 % de las muestras (al menos una) no cuenta,
+// ahí se llenan pools, cachés y el asignador; de las demás se compara el
+// primer tercio con el último (mínimo de RSS y mediana de las medianas, para
+// que un pico suelto no decida), así que hacen falta al menos 4 intervalos.
+class SoakMonitor {
+public:
+    void begin(const SoakLimits& limits);
+    // Duración de un tick de simulación y de un frame completo (el juego con
+    // ventana tiene los dos; headless solo ticks).
+    void addTick(float seconds) { ticks.push_back(seconds); }
+    void addFrame(float seconds) { frames.push_back(seconds); }
+    // Anota una muestra si pasó el intervalo. false cuando se cumplió la
+    // duración (la última muestra ya está tomada).
+    bool poll(const World& world, unsigned games);
+    // Imprime el resumen y devuelve si la prueba pasó.
+    bool finish() const;
+
+    // Memoria residente del proceso en bytes (0 si no se puede leer).
+    static size_t residentBytes();
+
+private:
+    struct Sample {
+        float seconds = 0.f;
+        size_t rss = 0;
+        size_t asteroids = 0, bullets = 0;
+        unsigned games = 0;
+        size_t ticks = 0;
+        float tickP50 = 0.f, tickP99 = 0.f, tickMax = 0.f;     // ms
+        float frameP50 = 0.f, frameP99 = 0.f, frameMax = 0.f;  // ms
+    };
+    void sample(const World& world, unsigned games, float seconds);
+
+    SoakLimits limits;
+    std::chrono::steady_clock::time_point start;
+    float nextSample = 0.f;
+    std::vector<float> ticks, frames; // del intervalo en curso (la capacidad se conserva)
+    std::vector<Sample> samples;
+};
@@ -0,0 +1,45 @@
+#pragma once
+#include <SFML/System.hpp>
+#include <cstdint>
+#include <vector>
+
+// Rejilla uniforme (spatial hash) sobre el mundo toroidal: las celdas de un
+// borde son vecinas de las del borde opuesto, igual que el wrap-around de las
+// entidades. Se reconstruye cada tick en O(n) con un conteo por celdas.
+//
+// Uso por tick: clear(), insert() por cada entidad, build(), y luego query().
+class SpatialGrid {
+public:
+    // Las celdas miden al menos `cellSize`; conviene que sea >= al radio típico.
+    SpatialGrid(float worldWidth, float worldHeight, float cellSize);
+
+    void clear();
+    // Registra el círculo `id` en todas las celdas que toca (envolviendo en los bordes).
+    void insert(std::uint32_t id, const sf::Vector2f& pos, float radius);
+    // Ordena las inserciones por celda; necesario antes de query().
+    void build();
+
+    // Escribe en `out` (ordenados y sin repetir) los ids que comparten celda con
+    // el círculo. `out` lo aporta quien llama para reutilizar memoria.
+    void query(const sf::Vector2f& pos, float radius, std::vector<std::uint32_t>& out) const;
+
+    int columns() const { return cols; }
+    int rows() const { return rowCount; }
+    size_t entryCount() const { return entries.size(); }
+
+private:
+    // Rango de celdas [first, last] (sin envolver) que cubre [lo, hi] en un eje.
+    void cellRange(float lo, float hi, float cellLen, int count, int& first, int& last) const;
+    template<class F> void forEachCell(const sf::Vector2f& pos, float radius, F&& fn) const;
+
+    int cols, rowCount;
+    float cellW, cellH;
+
+    // Inserciones pendientes (celda, id) y resultado en formato compacto:
+    // los ids de la celda c están en entries[cellStart[c] .. cellStart[c+1]).
+    std::vector<std::uint32_t> pendingCell;
+    std::vector<std::uint32_t> pendingId;
+    std::vector<std::uint32_t> cellStart;
+    std::vector<std::uint32_t> entries;
+    std::vector<std::uint32_t> cursor;
+};
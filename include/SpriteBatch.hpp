@@ -0,0 +1,53 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+// Región de una textura (normalmente el atlas de AssetManager) en píxeles.
+struct SpriteRegion {
+    const sf::Texture* texture = nullptr;
+    sf::FloatRect uv;
+    bool valid() const { return texture != nullptr; }
+};
+
+// Junta la geometría de muchas entidades en sf::VertexArray (triángulos) y la
+// envía con una sola llamada de dibujo por lote. Se abre un lote nuevo solo
+// cuando cambia la textura respecto al anterior, así se respeta el orden de
+// dibujo y el número de llamadas no depende de cuántas entidades haya.
+class SpriteBatch {
+public:
+    void begin();
+
+    // Quad con textura centrado en `center`; `uv` en píxeles de la textura.
+    void addQuad(const sf::Texture* texture, const sf::Vector2f& center, const sf::Vector2f& halfSize,
+                 const sf::FloatRect& uv, const sf::Color& color = sf::Color::White);
+    // Sprite completo de `region` centrado en `center`.
+    void addSprite(const SpriteRegion& region, const sf::Vector2f& center, const sf::Vector2f& halfSize,
+                   const sf::Color& color = sf::Color::White) {
+        addQuad(region.texture, center, halfSize, region.uv, color);
+    }
+    // Quad de color liso (esquina superior izquierda + tamaño).
+    void addRect(const sf::Vector2f& topLeft, const sf::Vector2f& size, const sf::Color& color);
+    void addTriangle(const sf::Vector2f& a, const sf::Vector2f& b, const sf::Vector2f& c, const sf::Color& color);
+    // Círculo relleno aproximado con `segments` triángulos.
+    void addCircle(const sf::Vector2f& center, float radius, const sf::Color& color, int segments = 12);
+    // Anillo (contorno de círculo) de grosor `thickness` hacia afuera.
+    void addRing(const sf::Vector2f& center, float radius, float thickness, const sf::Color& color, int segments = 24);
+
+    // Dibuja todos los lotes en orden. Devuelve cuántas llamadas de dibujo hizo.
+    unsigned flush(sf::RenderTarget& target, const sf::RenderStates& states = sf::RenderStates::Default);
+
+    size_t vertexCount() const;
+    // Lotes abiertos desde begin(): las llamadas que hará flush().
+    size_t batchCount() const { return used; }
+
+private:
+    struct Batch {
+        const sf::Texture* texture = nullptr;
+        sf::VertexArray vertices{sf::Triangles};
+    };
+    sf::VertexArray& batchFor(const sf::Texture* texture);
+
+    // Los lotes se reutilizan entre frames para no pedir memoria cada vez.
+    std::vector<Batch> batches;
+    size_t used = 0;
+};
@@ -0,0 +1,41 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+// Triple búfer sin bloqueos para un productor y un consumidor. El productor
+// escribe siempre en back() y lo publica; el consumidor lee front(), que no
+// cambia hasta que pide el último publicado con acquire(). Ninguno espera al
+// otro: si el productor publica dos veces antes de que el consumidor lea, el
+// valor intermedio simplemente se pierde.
+template <class T>
+class TripleBuffer {
+public:
+    // Lado del productor: el búfer que se está llenando.
+    T& back() { return slots[backIndex]; }
+
+    // Entrega back() y pasa a escribir en el que estaba en medio.
+    void publish() {
+        std::uint8_t prev = middle.exchange((std::uint8_t)(backIndex | FRESH), std::memory_order_acq_rel);
+        backIndex = prev & INDEX;
+    }
+
+    // Lado del consumidor: si hay algo publicado desde la última vez, pasa a
+    // leerlo. Devuelve false si front() sigue siendo el mismo.
+    bool acquire() {
+        if (!(middle.load(std::memory_order_relaxed) & FRESH)) return false;
+        std::uint8_t prev = middle.exchange(frontIndex, std::memory_order_acq_rel);
+        frontIndex = prev & INDEX;
+        return true;
+    }
+
+    const T& front() const { return slots[frontIndex]; }
+
+private:
+    static const std::uint8_t INDEX = 3;
+    static const std::uint8_t FRESH = 4; // el de en medio aún no lo ha visto el consumidor
+
+    T slots[3];
+    std::uint8_t backIndex = 0;            // solo lo toca el productor
+    std::uint8_t frontIndex = 1;           // solo lo toca el consumidor
+    std::atomic<std::uint8_t> middle{2};   // índice + FRESH, el único estado compartido
+};
@@ -0,0 +1,115 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <vector>
+#include "SpriteBatch.hpp"
+
+// Interfaz retenida: HUD, menú y pantalla de fin de juego. Cada widget se
+// acomoda una sola vez (layout) y solo regenera su texto o su geometría cuando
+// cambia el valor que muestra; el resto de los frames se vuelve a dibujar lo
+// mismo. Los rectángulos de los botones y opciones se calculan en el layout y
+// los usan tanto el dibujo como la entrada del ratón.
+
+// Texto con posición fija. Con setValue() recuerda el último número mostrado
+// y no vuelve a formatear ni a medir si no cambió.
+class UiLabel {
+public:
+    // Sin fuente (nullptr) la etiqueta existe pero no se dibuja.
+    void init(const sf::Font* font, unsigned size, const sf::Color& color);
+    // `centered`: `pos` es el centro del texto; si no, su esquina superior izquierda.
+    void place(const sf::Vector2f& pos, bool centered = false);
+    void setFormat(const std::string& prefix, const std::string& suffix = "");
+    void setText(const std::string& s);
+    void setValue(long long v);
+    void setColor(const sf::Color& c);
+
+    bool visible() const { return hasFont; }
+    sf::FloatRect bounds() const { return text.getGlobalBounds(); }
+    const sf::Text& drawable() const { return text; }
+
+private:
+    void relayout();
+
+    sf::Text text;
+    std::string current;
+    std::string prefix, suffix;
+    sf::Vector2f position;
+    bool centered = false;
+    bool hasFont = false;
+    bool hasValue = false;
+    long long value = 0;
+    sf::Color color;
+};
+
+// Controles del HUD que responden al ratón.
+enum class HudControl { None, VolumeBar, PrevTrack, PlayPause, NextTrack };
+
+// HUD de la partida: puntos, corazones, barra de volumen, botones de música y
+// la línea de depuración (F3). Las formas van en un SpriteBatch que se
+// reconstruye solo cuando cambian las vidas, el volumen o el estado de la música.
+class Hud {
+public:
+    void layout(const sf::Font* font, const SpriteRegion& heart, float width, float height);
+
+    // Se pueden llamar cada frame: sin cambios no hacen nada.
+    void setScore(int score);
+    void setLives(int lives);
+    void setVolume(float volume);
+    void setMusicPlaying(bool playing);
+    void setDebugStats(unsigned drawCalls, size_t vertices, size_t asteroids, size_t bullets, float renderScale);
+    // Tabla del perfilador (varias líneas) que acompaña a la línea de depuración.
+    void setProfileText(const std::string& text);
+
+    HudControl hitTest(const sf::Vector2f& p) const;
+    // Volumen 0-100 que corresponde a la coordenada `x` sobre la barra.
+    float volumeAt(float x) const;
+
+    // Devuelve cuántas llamadas de dibujo hizo.
+    unsigned draw(sf::RenderTarget& target, bool showDebug);
+
+private:
+    void rebuildGeometry();
+
+    UiLabel score, volumeText, debug, profile;
+    SpriteRegion heart;
+    SpriteBatch geometry;
+    bool dirty = true;
+
+    float width = 0.f;
+    int lives = -1;
+    float volume = -1.f;
+    bool musicPlaying = false;
+    unsigned debugKey[5] = {~0u, ~0u, ~0u, ~0u, ~0u};
+
+    sf::FloatRect volumeBarRect;
+    sf::FloatRect prevButtonRect, playPauseButtonRect, nextButtonRect;
+};
+
+// Menú principal: título y opciones centradas; la opción elegida en amarillo.
+class MenuUi {
+public:
+    void layout(const sf::Font* font, const std::vector<std::string>& options, float width, float height);
+    void setSelection(int index);
+    // Índice de la opción bajo `p`, o -1.
+    int hitTest(const sf::Vector2f& p) const;
+    // Solo las opciones; el título no cambia y va en la capa fija del fondo (Backdrop).
+    unsigned draw(sf::RenderTarget& target);
+    unsigned drawTitle(sf::RenderTarget& target) const;
+
+private:
+    UiLabel title;
+    std::vector<UiLabel> items;
+    std::vector<sf::FloatRect> itemRects;
+    int selection = -1;
+};
+
+// Pantalla de fin de juego sobre la partida.
+class GameOverUi {
+public:
+    void layout(const sf::Font* font, float width, float height);
+    void setScores(int finalScore, int bestScore);
+    unsigned draw(sf::RenderTarget& target);
+
+private:
+    UiLabel title, finalScore, bestScore, instructions;
+};
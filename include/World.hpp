@@ -0,0 +1,132 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "Ship.hpp"
+#include "EntityStore.hpp"
+#include "SpatialGrid.hpp"
+#include "Profiler.hpp"
+#include "Random.hpp"
+#include "JobSystem.hpp"
+
+class Box2DPhysics;
+
+// Estado de la simulación: nave, asteroides, balas, puntos y temporizadores.
+// No crea ventana ni carga audio o archivos; `Game` lo dibuja y lo hace sonar,
+// y el modo headless (make headless) lo avanza directamente.
+class World {
+public:
+    // Capacidad fija de los pools; jugar no pide memoria más allá de esto.
+    explicit World(size_t maxAsteroids = 4096, size_t maxBullets = 1024);
+
+    // Fija la semilla de la aleatoriedad de la simulación (generación y
+    // divisiones). La misma semilla y la misma entrada por tick dan la misma partida.
+    void seed(std::uint64_t s);
+    // Empieza una partida nueva (puntos, vidas, tiempo y nivel).
+    void newGame();
+    void resetLevel();
+    // Avanza la simulación `dt` segundos con la entrada dada.
+    void step(float dt, const ShipInput& input);
+    // Encola `n` asteroides nuevos en los bordes (aparecen en flushCommands()).
+    void spawnAsteroids(unsigned n);
+    // Aplica las altas y bajas encoladas. step() lo llama al final de cada tick.
+    void flushCommands();
+    bool isGameOver() const { return lives <= 0; }
+    // Huella del estado (puntos, vidas, nave y entidades vivas, bit a bit) para
+    // comprobar que una repetición o una optimización no cambió la partida.
+    std::uint64_t checksum() const;
+
+    Ship player;
+    // Naves de los demás jugadores en una partida en red (ver NetServer): quien
+    // las maneja pone `input` antes de cada step(). Se mueven, disparan y
+    // chocan igual que `player` y comparten sus puntos y vidas.
+    struct Guest {
+        std::uint8_t id = 0;
+        Ship ship;
+        ShipInput input;
+        float timeSinceLastShot = 0.f;
+    };
+    std::vector<Guest> guests;
+    AsteroidStore asteroids;
+    BulletStore bullets;
+
+    int score = 0;
+    int maxScore = 0;
+    int lives = 3;
+    float timeSinceLastShot = 0.f;
+    float asteroidTimer = 0.f;
+    // Registra el tiempo total de juego (segundos) para aumentar la dificultad con el tiempo
+    float elapsedTime = 0.f;
+
+    // Eventos del último step(), para que la capa de presentación reproduzca sonidos.
+    int shotsFired = 0;
+    int asteroidsDestroyed = 0;
+    // Explosiones del último step() (asteroides destruidos y la nave), para
+    // los efectos visuales; en el orden en que ocurrieron.
+    struct Explosion {
+        sf::Vector2f position;
+        sf::Vector2f velocity;
+        float radius;
+        bool ship;
+    };
+    std::vector<Explosion> explosions;
+    // Altas descartadas porque el pool estaba lleno (acumulado de la partida).
+    unsigned droppedSpawns = 0;
+
+    // Opcional: mide entrada, integración, colisiones y generación de cada tick.
+    Profiler* profiler = nullptr;
+    // Opcional: reparte integración y colisiones entre hilos. El resultado es
+    // el mismo bit a bit con o sin él, con cualquier número de hilos.
+    JobSystem* jobs = nullptr;
+    // Opcional: integración y contactos con Box2D en lugar de los núcleos SoA y
+    // la rejilla (ver Box2DPhysics.hpp). Las reglas son las mismas, pero la
+    // partida no coincide bit a bit con la del motor propio.
+    Box2DPhysics* physics = nullptr;
+
+private:
+    friend struct WorldState; // guarda y restaura rng
+    Rng rng;
+
+    // Rejilla de asteroides usada por todas las consultas de colisión del tick.
+    SpatialGrid asteroidGrid;
+    std::vector<std::uint32_t> candidates;
+    // Pares bala-asteroide que se tocan, una lista por trozo de balas, y una
+    // lista de candidatos por hilo; se reutilizan de un tick a otro.
+    // `toi`: fracción del tick en que se tocan (ver sweptCollision).
+    struct HitPair { std::uint32_t bullet, asteroid; float toi; };
+    std::vector<std::vector<HitPair>> hitPairs;
+    std::vector<std::vector<std::uint32_t>> queryScratch;
+
+    // Comandos diferidos del tick: nadie agrega ni quita entidades mientras se
+    // recorren; se aplican juntos en flushCommands(). Capacidad fija (la del pool).
+    std::vector<Asteroid> asteroidSpawns;
+    std::vector<Bullet> bulletSpawns;
+    std::vector<std::uint32_t> asteroidDespawns;
+    std::vector<std::uint32_t> bulletDespawns;
+
+    void queueSpawn(const Asteroid& a);
+    void queueSpawn(const Bullet& b);
+
+    // Trayecto de un círculo durante el último tick: posición al empezar,
+    // desplazamiento y salto por el borde (0 en el eje en que no dio la vuelta).
+    struct Sweep {
+        sf::Vector2f start, delta, jump;
+        bool jumped() const { return jump.x != 0.f || jump.y != 0.f; }
+    };
+    static Sweep sweepOf(const sf::Vector2f& prev, const sf::Vector2f& pos, const sf::Vector2f& vel, float dt);
+
+    // Cada asteroide entra con su radio más lo que se movió en el tick (y
+    // también en el lado de antes del salto si dio la vuelta).
+    void rebuildAsteroidGrid(float dt);
+    // Balas contra asteroides y naves contra asteroides; encola las bajas y los hijos.
+    void resolveCollisions(float dt);
+    // Una nave contra los asteroides (barrido; la de `player` con Box2D, sus contactos).
+    void collideShip(Ship& ship, float dt);
+    // Explosión, vidas y reaparición en el centro.
+    void destroyShip(Ship& ship);
+    // Pares bala-asteroide del tick con la rejilla, en hitPairs; devuelve cuántas listas se usaron.
+    size_t findBulletHits(float dt);
+    // Choque barrido: true si los círculos se tocan en algún momento del tick,
+    // con la primera fracción del tick en que lo hacen en `toi`. Prueba también
+    // los trayectos después del salto de quien haya dado la vuelta.
+    static bool sweptCollision(const Sweep& a, float aR, const Sweep& b, float bR, float& toi);
+};
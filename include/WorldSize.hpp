@@ -0,0 +1,7 @@
+#pragma once
+
+// Tamaño del mundo en unidades de juego, fijo e independiente de la ventana:
+// la simulación siempre es de 1280x720 y Game la lleva a los píxeles que haya
+// con un sf::View (con bandas negras si la proporción no coincide).
+const float WORLD_WIDTH = 1280.f;
+const float WORLD_HEIGHT = 720.f;
@@ -0,0 +1,24 @@
+#pragma once
+#include <vector>
+#include "Asteroid.hpp"
+#include "Bullet.hpp"
+#include "Ship.hpp"
+
+class World;
+
+// Copia inmutable de lo que hace falta para dibujar el mundo en un tick:
+// entidades vivas (con su estado anterior para interpolar) y los valores del
+// HUD. El dibujo lee de aquí y no del World, así puede ir en otro hilo.
+struct WorldSnapshot {
+    std::vector<Asteroid> asteroids;
+    std::vector<Bullet> bullets;
+    Ship player;
+    std::vector<Ship> guests; // naves de los otros jugadores en red
+    int score = 0;
+    int maxScore = 0;
+    int lives = 0;
+    bool gameOver = false;
+
+    // Reutiliza la memoria de los vectores: sin asignaciones una vez que han crecido.
+    void capture(const World& world);
+};
@@ -0,0 +1,36 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class World;
+
+// Estado completo de la simulación en binario: nave (y naves invitadas),
+// arreglos de asteroides y balas, puntos, vidas, temporizadores y el estado
+// del Rng. Restaurarlo y seguir con la misma entrada da la misma partida bit
+// a bit que si no se hubiera parado (mismo binario y motor propio; con Box2D
+// los cuerpos se rehacen y la continuación ya no coincide).
+//
+// Formato: "ASTS", versión u32, y de asteroides y de balas los slots en uso
+// y el ancho de columna (u32 cada uno), invitados u8 y después los valores;
+// enteros en little-endian y flotantes como sus bits. Los arreglos de los
+// pools van por columnas y cada columna de flotantes por planos de bytes
+// (primero el byte bajo de todos, ...): entre dos estados cercanos los bytes
+// altos casi no cambian, así el delta de RewindBuffer queda en rachas de
+// ceros. Cada columna mide slots() redondeado a bloques de 16 (al menos uno,
+// el resto con ceros) y los slots muertos por debajo también se guardan: un
+// slot cae siempre en el mismo desplazamiento mientras el pool no cruce un
+// bloque, aunque crezca un slot o se vacíe. Unos 31 bytes por slot de
+// asteroide y 30 por slot de bala.
+struct WorldState {
+    std::vector<std::uint8_t> bytes;
+
+    // Reutiliza la memoria de `bytes`: sin asignaciones una vez que ha crecido.
+    void capture(const World& world);
+    // false (y `world` sin tocar) si los datos están mal o no caben en sus pools.
+    // Las altas y bajas encoladas y los eventos del último step() quedan vacíos.
+    bool restore(World& world) const;
+
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+};
@@ -0,0 +1,184 @@
+#include "AssetManager.hpp"
+#include <algorithm>
+
+// Separación entre imágenes del atlas para que el filtrado no mezcle vecinos.
+static const unsigned ATLAS_PADDING = 2;
+
+AssetManager::~AssetManager() {
+    stopLoading();
+}
+
+bool AssetManager::mountPack(const std::string& path) {
+    return archive.open(path);
+}
+
+bool AssetManager::loadFont(sf::Font& font, const std::string& path) const {
+    const PackEntry* e = archive.find(path);
+    // la fuente lee de esos bytes mientras viva: el mapeo dura lo mismo que el AssetManager
+    if (e) return font.loadFromMemory(e->data, e->size);
+    return font.loadFromFile(path);
+}
+
+bool AssetManager::loadSound(sf::SoundBuffer& buffer, const std::string& path) const {
+    const PackEntry* e = archive.find(path);
+    if (!e) return buffer.loadFromFile(path);
+    if (e->kind == PackEntryKind::Pcm)
+        return buffer.loadFromSamples((const sf::Int16*)e->data, e->size / 2, e->b, e->a);
+    return buffer.loadFromMemory(e->data, e->size);
+}
+
+// Imagen RGBA del paquete con el tamaño que dice su entrada.
+static bool isRgba(const PackEntry* e) {
+    return e && e->kind == PackEntryKind::Rgba && (std::uint64_t)e->a * e->b * 4 == e->size;
+}
+
+void AssetManager::queueSprite(SpriteId id, const std::string& path) {
+    size_t i = (size_t)id;
+    const PackEntry* e = archive.find(path);
+    // cada tarea escribe solo en su propia imagen; loaded[] se marca en el hilo principal
+    queueTask([this, i, path, e] {
+                  if (isRgba(e)) { images[i].create(e->a, e->b, e->data); return true; }
+                  return images[i].loadFromFile(path);
+              },
+              [this, i](bool ok) { loaded[i] = ok; });
+}
+
+TextureHandle AssetManager::queueTexture(const std::string& path) {
+    TextureHandle h = (TextureHandle)textures.size();
+    textures.push_back(std::make_unique<sf::Texture>());
+    textureImages.emplace_back();
+    textureReady.push_back(false);
+    const PackEntry* e = archive.find(path);
+    if (isRgba(e)) {
+        // ya en RGBA: se sube directamente desde el mapeo, sin copia intermedia
+        queueTask([] { return true; }, [this, h, e](bool) {
+            textureReady[h] = textures[h]->create(e->a, e->b);
+            if (textureReady[h]) textures[h]->update(e->data);
+        });
+        return h;
+    }
+    queueTask([this, h, path] { return textureImages[h].loadFromFile(path); },
+              [this, h](bool ok) {
+                  textureReady[h] = ok && textures[h]->loadFromImage(textureImages[h]);
+                  textureImages[h] = sf::Image();
+              });
+    return h;
+}
+
+void AssetManager::queueTask(std::function<bool()> work, std::function<void(bool)> done) {
+    auto t = std::make_unique<LoadTask>();
+    t->work = std::move(work);
+    t->done = std::move(done);
+    tasks.push_back(std::move(t));
+}
+
+void AssetManager::startLoading(unsigned threads) {
+    if (threads == 0) threads = std::max(2u, std::thread::hardware_concurrency());
+    threads = std::min<unsigned>(threads, (unsigned)tasks.size());
+    for (unsigned i = 0; i < threads; ++i) loaders.emplace_back(&AssetManager::loaderLoop, this);
+}
+
+void AssetManager::loaderLoop() {
+    // las tareas no cambian de lugar mientras hay hilos: basta un índice atómico
+    for (;;) {
+        size_t i = nextTask.fetch_add(1);
+        if (i >= tasks.size()) return;
+        LoadTask& t = *tasks[i];
+        t.ok = t.work();
+        t.finished.store(true, std::memory_order_release);
+    }
+}
+
+bool AssetManager::poll() {
+    if (atlasBuilt) return true;
+    for (auto& t : tasks) {
+        if (t->collected || !t->finished.load(std::memory_order_acquire)) continue;
+        t->collected = true;
+        collected++;
+        if (t->done) t->done(t->ok);
+    }
+    if (collected < tasks.size()) return false;
+
+    for (std::thread& th : loaders) th.join();
+    loaders.clear();
+    buildAtlas();
+    atlasBuilt = true;
+    return true;
+}
+
+float AssetManager::progress() const {
+    // el atlas cuenta como un paso más
+    return (float)(collected + (atlasBuilt ? 1 : 0)) / (float)(tasks.size() + 1);
+}
+
+void AssetManager::stopLoading() {
+    nextTask.store(tasks.size());
+    for (std::thread& th : loaders) th.join();
+    loaders.clear();
+}
+
+bool AssetManager::buildAtlas() {
+    // ordenar por altura (de mayor a menor) y acomodar en estantes
+    std::vector<size_t> order;
+    unsigned widest = 0;
+    for (size_t i = 0; i < SPRITE_COUNT; ++i) {
+        if (!loaded[i]) continue;
+        order.push_back(i);
+        widest = std::max(widest, images[i].getSize().x);
+    }
+    if (order.empty()) return false;
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return images[a].getSize().y > images[b].getSize().y;
+    });
+
+    const unsigned atlasWidth = std::max(1024u, widest + ATLAS_PADDING);
+    std::array<sf::Vector2u, SPRITE_COUNT> placement;
+    unsigned x = 0, y = 0, shelfHeight = 0;
+    for (size_t i : order) {
+        sf::Vector2u size = images[i].getSize();
+        if (x + size.x > atlasWidth) { // estante lleno: abrir uno nuevo debajo
+            x = 0;
+            y += shelfHeight + ATLAS_PADDING;
+            shelfHeight = 0;
+        }
+        placement[i] = {x, y};
+        x += size.x + ATLAS_PADDING;
+        shelfHeight = std::max(shelfHeight, size.y);
+    }
+    const unsigned atlasHeight = y + shelfHeight;
+
+    if (atlasWidth > sf::Texture::getMaximumSize() || atlasHeight > sf::Texture::getMaximumSize()) {
+        // la GPU no admite un atlas tan grande: cada imagen en su propia textura
+        for (size_t i : order) {
+            TextureHandle h = (TextureHandle)textures.size();
+            textures.push_back(std::make_unique<sf::Texture>());
+            textureImages.emplace_back();
+            textureReady.push_back(false);
+            if (!textures[h]->loadFromImage(images[i])) continue;
+            textureReady[h] = true;
+            sf::Vector2u size = images[i].getSize();
+            regions[i].texture = textures[h].get();
+            regions[i].uv = sf::FloatRect(0.f, 0.f, (float)size.x, (float)size.y);
+        }
+        return false;
+    }
+
+    sf::Image packed;
+    packed.create(atlasWidth, atlasHeight, sf::Color::Transparent);
+    for (size_t i : order) packed.copy(images[i], placement[i].x, placement[i].y);
+    if (!atlas.loadFromImage(packed)) return false;
+
+    for (size_t i : order) {
+        sf::Vector2u size = images[i].getSize();
+        regions[i].texture = &atlas;
+        regions[i].uv = sf::FloatRect((float)placement[i].x, (float)placement[i].y, (float)size.x, (float)size.y);
+        // la copia en CPU ya no hace falta
+        images[i] = sf::Image();
+    }
+    return true;
+}
+
+const sf::Texture* AssetManager::texture(TextureHandle h) const {
+    if (h < 0 || h >= (TextureHandle)textures.size() || !textureReady[h]) return nullptr;
+    return textures[h].get();
+}
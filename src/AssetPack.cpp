@@ -0,0 +1,99 @@
+#include "AssetPack.hpp"
+#include <algorithm>
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+AssetPack::~AssetPack() {
+    close();
+}
+
+static bool readInt(const std::uint8_t* base, size_t length, size_t& pos, std::uint32_t& v, int bytes) {
+    if (pos + bytes > length) return false;
+    v = 0;
+    for (int i = 0; i < bytes; ++i) v |= (std::uint32_t)base[pos++] << (8*i);
+    return true;
+}
+
+bool AssetPack::open(const std::string& path) {
+    close();
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) { CloseHandle(file); return false; }
+    HANDLE map = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!map) return false;
+    void* view = MapViewOfFile(map, FILE_MAP_READ, 0, 0, 0);
+    if (!view) { CloseHandle(map); return false; }
+    mapping = map;
+    base = (const std::uint8_t*)view;
+    length = (size_t)fileSize.QuadPart;
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) { ::close(fd); return false; }
+    void* view = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // el mapeo sigue vivo sin el descriptor
+    if (view == MAP_FAILED) return false;
+    base = (const std::uint8_t*)view;
+    length = (size_t)st.st_size;
+#endif
+
+    // cabecera e índice; cualquier cosa fuera de rango invalida el paquete
+    size_t pos = 4;
+    std::uint32_t version, count, tocOffset;
+    bool ok = length >= 16 && std::memcmp(base, ASSET_PACK_MAGIC, 4) == 0
+        && readInt(base, length, pos, version, 4) && version == ASSET_PACK_VERSION
+        && readInt(base, length, pos, count, 4) && readInt(base, length, pos, tocOffset, 4);
+    pos = tocOffset;
+    entries.reserve(ok ? std::min<size_t>(count, length / 19) : 0);
+    for (std::uint32_t i = 0; ok && i < count; ++i) {
+        std::uint32_t nameLength, kind, offset;
+        PackEntry e;
+        ok = readInt(base, length, pos, nameLength, 2) && pos + nameLength <= length;
+        if (!ok) break;
+        e.name.assign((const char*)base + pos, nameLength);
+        pos += nameLength;
+        ok = readInt(base, length, pos, kind, 1) && kind <= (std::uint32_t)PackEntryKind::Pcm
+            && readInt(base, length, pos, offset, 4) && readInt(base, length, pos, e.size, 4)
+            && readInt(base, length, pos, e.a, 4) && readInt(base, length, pos, e.b, 4)
+            && (size_t)offset + e.size <= length;
+        if (!ok) break;
+        e.kind = (PackEntryKind)kind;
+        e.data = base + offset;
+        entries.push_back(std::move(e));
+    }
+    if (!ok) close();
+    return ok;
+}
+
+void AssetPack::close() {
+    entries.clear();
+    if (!base) return;
+#ifdef _WIN32
+    UnmapViewOfFile(base);
+    CloseHandle(mapping);
+    mapping = nullptr;
+#else
+    munmap((void*)base, length);
+#endif
+    base = nullptr;
+    length = 0;
+}
+
+const PackEntry* AssetPack::find(const std::string& name) const {
+    auto it = std::lower_bound(entries.begin(), entries.end(), name,
+                               [](const PackEntry& e, const std::string& n) { return e.name < n; });
+    return it != entries.end() && it->name == name ? &*it : nullptr;
+}
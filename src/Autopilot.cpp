@@ -0,0 +1,65 @@
+#include "Autopilot.hpp"
+#include "World.hpp"
+#include "WorldSize.hpp"
+#include <cmath>
+
+// Rapidez de la bala respecto de la nave (Ship::shoot) y su alcance (2 s).
+static const float BULLET_SPEED = 400.f;
+static const float SHOT_RANGE = 600.f;
+// Error de puntería (grados) por debajo del cual deja de girar y dispara.
+static const float AIM_TOLERANCE = 4.f;
+static const float FIRE_TOLERANCE = 10.f;
+// Empuja si el blanco está más lejos que esto y la nave va más lenta que MAX_SPEED.
+static const float APPROACH_DISTANCE = 320.f;
+static const float MAX_SPEED = 120.f;
+
+// Diferencia más corta en un eje que da la vuelta.
+static float wrapDelta(float d, float size) {
+    if (d > size * 0.5f) d -= size;
+    else if (d < -size * 0.5f) d += size;
+    return d;
+}
+
+ShipInput autopilotInput(const World& world, const Ship& ship) {
+    ShipInput in;
+    if (!ship.alive) return in;
+
+    // el asteroide más cercano, midiendo a través de los bordes
+    const AsteroidStore& as = world.asteroids;
+    int target = -1;
+    float bestDx = 0.f, bestDy = 0.f, bestDist2 = 0.f;
+    for (size_t i = 0; i < as.slots(); ++i) {
+        if (!as.alive[i]) continue;
+        float dx = wrapDelta(as.x[i] - ship.position.x, WORLD_WIDTH);
+        float dy = wrapDelta(as.y[i] - ship.position.y, WORLD_HEIGHT);
+        float d2 = dx*dx + dy*dy;
+        if (target < 0 || d2 < bestDist2) { target = (int)i; bestDx = dx; bestDy = dy; bestDist2 = d2; }
+    }
+    if (target < 0) {
+        in.right = true; // sin blancos: girar en el sitio
+        return in;
+    }
+
+    // adelanto: la bala hereda la velocidad de la nave, así que cuenta la relativa
+    const float rvx = as.vx[target] - ship.velocity.x;
+    const float rvy = as.vy[target] - ship.velocity.y;
+    float aimX = bestDx, aimY = bestDy;
+    for (int k = 0; k < 2; ++k) {
+        float t = std::sqrt(aimX*aimX + aimY*aimY) / BULLET_SPEED;
+        aimX = bestDx + rvx * t;
+        aimY = bestDy + rvy * t;
+    }
+
+    float error = std::atan2(aimY, aimX) * 180.f / 3.14159f - ship.angle;
+    error = std::fmod(error, 360.f);
+    if (error > 180.f) error -= 360.f;
+    else if (error < -180.f) error += 360.f;
+    if (error > AIM_TOLERANCE) in.right = true;
+    else if (error < -AIM_TOLERANCE) in.left = true;
+
+    const float dist = std::sqrt(bestDist2);
+    in.shoot = std::fabs(error) < FIRE_TOLERANCE && dist < SHOT_RANGE;
+    const float speed = std::sqrt(ship.velocity.x*ship.velocity.x + ship.velocity.y*ship.velocity.y);
+    in.thrust = dist > APPROACH_DISTANCE && speed < MAX_SPEED && std::fabs(error) < 2.f * FIRE_TOLERANCE;
+    return in;
+}
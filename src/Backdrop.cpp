@@ -0,0 +1,102 @@
+#include "Backdrop.hpp"
+#include "Ui.hpp"
+#include <algorithm>
+#include <cmath>
+
+// Deriva de las estrellas sin nave (px/s en la capa más cercana).
+static const sf::Vector2f STAR_DRIFT(-12.f, 0.f);
+
+void Backdrop::layout(const sf::Texture* bg, float w, float h) {
+    background = bg;
+    width = w;
+    height = h;
+    // de la más lejana (muchas, tenues, casi quietas) a la más cercana
+    const unsigned counts[STAR_LAYERS] = {140, 80, 35};
+    const float parallax[STAR_LAYERS] = {0.04f, 0.12f, 0.3f};
+    const float sizes[STAR_LAYERS] = {1.f, 1.5f, 2.5f};
+    const sf::Uint8 light[STAR_LAYERS] = {90, 150, 230};
+    rng.seed(7);
+    for (int l = 0; l < STAR_LAYERS; ++l) {
+        StarLayer& layer = starLayers[l];
+        layer.stars.resize(counts[l]);
+        for (sf::Vector2f& s : layer.stars) s = {rng.uniform(0.f, w), rng.uniform(0.f, h)};
+        layer.offset = {0.f, 0.f};
+        layer.parallax = parallax[l];
+        layer.size = sizes[l];
+        layer.color = sf::Color(light[l], light[l], (sf::Uint8)std::min(255, light[l] + 25));
+        layer.vertices.resize(layer.stars.size() * 6);
+    }
+    gameDirty = menuDirty = true;
+}
+
+void Backdrop::resize(sf::Vector2u size) {
+    if (size == pixels) return;
+    pixels = size;
+    gameDirty = menuDirty = true;
+}
+
+void Backdrop::update(float dt, const sf::Vector2f& shipVelocity) {
+    for (StarLayer& layer : starLayers) {
+        // contra la nave: si avanza a la derecha, el fondo se va a la izquierda
+        layer.offset += (STAR_DRIFT - shipVelocity) * layer.parallax * dt;
+        layer.offset.x = std::fmod(layer.offset.x, width);
+        layer.offset.y = std::fmod(layer.offset.y, height);
+    }
+}
+
+void Backdrop::rebuild(sf::RenderTexture& layer, sf::Sprite& sprite, bool& dirty, const MenuUi* menu) {
+    if (!dirty) return;
+    sf::Vector2u size(pixels.x ? pixels.x : (unsigned)width, pixels.y ? pixels.y : (unsigned)height);
+    if (layer.getSize() != size && !layer.create(size.x, size.y)) return;
+    // se pinta en coordenadas de la escena; la vista lo lleva a los píxeles de la capa
+    layer.setView(sf::View(sf::FloatRect(0.f, 0.f, width, height)));
+    layer.clear(menu && !background ? sf::Color(10,10,30) : sf::Color::Black);
+    if (background) {
+        sf::Sprite bg(*background);
+        sf::Vector2u tx = background->getSize();
+        bg.setScale(width / (float)tx.x, height / (float)tx.y);
+        layer.draw(bg);
+    }
+    if (menu) menu->drawTitle(layer);
+    layer.display();
+    sprite.setTexture(layer.getTexture(), true);
+    sprite.setScale(width / (float)size.x, height / (float)size.y);
+    // solo ahora: si create() falló se vuelve a intentar en el próximo frame
+    dirty = false;
+}
+
+unsigned Backdrop::draw(sf::RenderTarget& target) {
+    unsigned calls = 0;
+    if (background) {
+        rebuild(gameLayer, gameSprite, gameDirty, nullptr);
+        target.draw(gameSprite);
+        calls++;
+    }
+    return calls + drawStars(target);
+}
+
+unsigned Backdrop::drawMenu(sf::RenderTarget& target, const MenuUi& menu) {
+    rebuild(menuLayer, menuSprite, menuDirty, &menu);
+    target.draw(menuSprite);
+    return 1 + drawStars(target);
+}
+
+unsigned Backdrop::drawStars(sf::RenderTarget& target) {
+    unsigned calls = 0;
+    for (StarLayer& layer : starLayers) {
+        float h = layer.size * 0.5f;
+        for (size_t i = 0; i < layer.stars.size(); ++i) {
+            // posición con el desplazamiento de la capa, envuelta a la pantalla
+            float x = layer.stars[i].x + layer.offset.x, y = layer.stars[i].y + layer.offset.y;
+            if (x < 0.f) x += width; else if (x >= width) x -= width;
+            if (y < 0.f) y += height; else if (y >= height) y -= height;
+            sf::Vertex* v = &layer.vertices[i * 6];
+            v[0].position = {x - h, y - h}; v[1].position = {x + h, y - h}; v[2].position = {x + h, y + h};
+            v[3].position = {x - h, y - h}; v[4].position = {x + h, y + h}; v[5].position = {x - h, y + h};
+            for (int k = 0; k < 6; ++k) v[k].color = layer.color;
+        }
+        target.draw(layer.vertices);
+        calls++;
+    }
+    return calls;
+}
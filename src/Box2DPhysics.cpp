@@ -0,0 +1,238 @@
+#include "Box2DPhysics.hpp"
+#include "World.hpp"
+#include "WorldSize.hpp"
+#include <algorithm>
+#include <cmath>
+
+#ifdef ASTEROIDS_BOX2D
+#include <box2d/box2d.h>
+
+// Box2D está afinado para objetos de 0.1 a 10 m: un asteroide grande mide
+// ~0.75 m y una bala ~0.05 m (por encima del margen de contacto de 5 mm).
+static const float PIXELS_PER_METER = 64.f;
+static const int VELOCITY_ITERATIONS = 8;
+static const int POSITION_ITERATIONS = 3;
+// La atenuación de Ship::update (0.995 a 120 Hz) como amortiguación lineal de Box2D
+static const float SHIP_DAMPING = -120.f * std::log(0.995f);
+
+// Categorías de colisión: las balas no chocan entre sí ni con la nave.
+static const std::uint16_t SHIP_BIT = 1, ASTEROID_BIT = 2, BULLET_BIT = 4;
+
+// El dato de usuario de cada cuerpo: tipo en los bits altos y slot del pool abajo.
+enum class BodyKind : std::uintptr_t { Ship = 1, Asteroid = 2, Bullet = 3 };
+static const unsigned KIND_SHIFT = 24;
+
+static std::uintptr_t bodyTag(BodyKind kind, std::uint32_t slot) {
+    return ((std::uintptr_t)kind << KIND_SHIFT) | slot;
+}
+
+static BodyKind kindOf(std::uintptr_t tag) {
+    return (BodyKind)(tag >> KIND_SHIFT);
+}
+
+static std::uint32_t slotOf(std::uintptr_t tag) {
+    return (std::uint32_t)(tag & ((1u << KIND_SHIFT) - 1));
+}
+
+static b2Vec2 toMeters(float x, float y) {
+    return b2Vec2(x / PIXELS_PER_METER, y / PIXELS_PER_METER);
+}
+
+// Mismo envolvimiento que los núcleos SoA: p < -m pasa a limit+m y al revés.
+static bool wrapAxis(float& p, float limit, float m) {
+    if (p < -m) { p = limit + m; return true; }
+    if (p > limit + m) { p = -m; return true; }
+    return false;
+}
+
+// Cuerpo de un slot y el estado que se escribió en el pool tras el último paso:
+// si el pool ya no coincide, alguien lo cambió (alta nueva en el mismo slot,
+// la nave reaparecida) y el cuerpo se mueve o se rehace.
+struct Mirror {
+    b2Body* body = nullptr;
+    float x = 0.f, y = 0.f, vx = 0.f, vy = 0.f, radius = 0.f;
+};
+
+struct Box2DPhysics::Impl : b2ContactListener {
+    explicit Impl(Box2DPhysics& owner) : owner(owner) {
+        world.SetContactListener(this);
+    }
+
+    // Solo los contactos de balas y nave: se anotan y no se resuelven (sin rebote).
+    void PreSolve(b2Contact* contact, const b2Manifold*) override {
+        std::uintptr_t a = contact->GetFixtureA()->GetBody()->GetUserData().pointer;
+        std::uintptr_t b = contact->GetFixtureB()->GetBody()->GetUserData().pointer;
+        if (kindOf(a) > kindOf(b)) std::swap(a, b);
+        if (kindOf(a) == BodyKind::Asteroid && kindOf(b) == BodyKind::Asteroid) return;
+        contact->SetEnabled(false);
+        if (kindOf(a) == BodyKind::Ship && kindOf(b) == BodyKind::Asteroid)
+            owner.shipContacts.push_back(slotOf(b));
+        else if (kindOf(a) == BodyKind::Asteroid && kindOf(b) == BodyKind::Bullet)
+            owner.hits.push_back({slotOf(b), slotOf(a)});
+    }
+
+    b2Body* createBody(BodyKind kind, std::uint32_t slot, float x, float y, float radius) {
+        b2BodyDef def;
+        def.type = b2_dynamicBody;
+        def.position = toMeters(x, y);
+        def.fixedRotation = true;
+        def.allowSleep = false;
+        def.bullet = kind == BodyKind::Bullet;
+        def.linearDamping = kind == BodyKind::Ship ? SHIP_DAMPING : 0.f;
+        def.userData.pointer = bodyTag(kind, slot);
+        b2Body* body = world.CreateBody(&def);
+
+        b2CircleShape shape;
+        shape.m_radius = radius / PIXELS_PER_METER;
+        b2FixtureDef fixture;
+        fixture.shape = &shape;
+        fixture.density = 1.f;   // masa según el área: los grandes empujan a los chicos
+        fixture.friction = 0.f;
+        fixture.restitution = 1.f;
+        fixture.restitutionThreshold = 0.f; // rebote elástico también a poca velocidad
+        switch (kind) {
+            case BodyKind::Ship: fixture.filter.categoryBits = SHIP_BIT; fixture.filter.maskBits = ASTEROID_BIT; break;
+            case BodyKind::Asteroid: fixture.filter.categoryBits = ASTEROID_BIT; break;
+            case BodyKind::Bullet: fixture.filter.categoryBits = BULLET_BIT; fixture.filter.maskBits = ASTEROID_BIT; break;
+        }
+        body->CreateFixture(&fixture);
+        return body;
+    }
+
+    // Crea, mueve o borra los cuerpos de un pool según lo que cambió desde el último paso.
+    template <class Store, class Radius>
+    void syncStore(Store& s, std::vector<Mirror>& mirrors, BodyKind kind, Radius radiusOf) {
+        if (mirrors.size() < s.slots()) mirrors.resize(s.slots());
+        for (size_t i = 0; i < mirrors.size(); ++i) {
+            Mirror& m = mirrors[i];
+            if (i >= s.slots() || !s.alive[i]) {
+                if (m.body) world.DestroyBody(m.body);
+                m.body = nullptr;
+                continue;
+            }
+            const float r = radiusOf(i);
+            if (m.body && m.x == s.x[i] && m.y == s.y[i] && m.vx == s.vx[i] && m.vy == s.vy[i] && m.radius == r)
+                continue;
+            if (m.body && m.radius == r) {
+                m.body->SetTransform(toMeters(s.x[i], s.y[i]), 0.f);
+            } else {
+                if (m.body) world.DestroyBody(m.body);
+                m.body = createBody(kind, (std::uint32_t)i, s.x[i], s.y[i], r);
+            }
+            m.body->SetLinearVelocity(toMeters(s.vx[i], s.vy[i]));
+            m = {m.body, s.x[i], s.y[i], s.vx[i], s.vy[i], r};
+        }
+    }
+
+    // Copia posición y velocidad de vuelta al pool (la anterior queda en prevX/prevY).
+    template <class Store, class Margin>
+    void readStore(Store& s, std::vector<Mirror>& mirrors, Margin marginOf) {
+        for (size_t i = 0; i < s.slots(); ++i) {
+            Mirror& m = mirrors[i];
+            if (!m.body) continue;
+            const b2Vec2& p = m.body->GetPosition();
+            const b2Vec2& v = m.body->GetLinearVelocity();
+            float x = p.x * PIXELS_PER_METER, y = p.y * PIXELS_PER_METER;
+            const float margin = marginOf(i);
+            bool wrapped = wrapAxis(x, WORLD_WIDTH, margin);
+            wrapped = wrapAxis(y, WORLD_HEIGHT, margin) || wrapped;
+            if (wrapped) m.body->SetTransform(toMeters(x, y), 0.f);
+            s.prevX[i] = s.x[i];
+            s.prevY[i] = s.y[i];
+            s.x[i] = m.x = x;
+            s.y[i] = m.y = y;
+            s.vx[i] = m.vx = v.x * PIXELS_PER_METER;
+            s.vy[i] = m.vy = v.y * PIXELS_PER_METER;
+        }
+    }
+
+    void syncShip(Ship& ship) {
+        if (!shipBody) shipBody = createBody(BodyKind::Ship, 0, ship.position.x, ship.position.y, ship.radius);
+        else if (ship.position.x != shipX || ship.position.y != shipY)
+            shipBody->SetTransform(toMeters(ship.position.x, ship.position.y), 0.f);
+        // la velocidad siempre: el empuje de handleInput la cambia cada tick
+        shipBody->SetLinearVelocity(toMeters(ship.velocity.x, ship.velocity.y));
+    }
+
+    void readShip(Ship& ship) {
+        const b2Vec2& p = shipBody->GetPosition();
+        const b2Vec2& v = shipBody->GetLinearVelocity();
+        sf::Vector2f pos(p.x * PIXELS_PER_METER, p.y * PIXELS_PER_METER);
+        // la nave envuelve sin margen, como en Ship::update
+        bool wrapped = false;
+        if (pos.x < 0) { pos.x += WORLD_WIDTH; wrapped = true; }
+        if (pos.x > WORLD_WIDTH) { pos.x -= WORLD_WIDTH; wrapped = true; }
+        if (pos.y < 0) { pos.y += WORLD_HEIGHT; wrapped = true; }
+        if (pos.y > WORLD_HEIGHT) { pos.y -= WORLD_HEIGHT; wrapped = true; }
+        if (wrapped) shipBody->SetTransform(toMeters(pos.x, pos.y), 0.f);
+        ship.position = pos;
+        ship.velocity = sf::Vector2f(v.x * PIXELS_PER_METER, v.y * PIXELS_PER_METER);
+        shipX = pos.x;
+        shipY = pos.y;
+    }
+
+    Box2DPhysics& owner;
+    b2World world{b2Vec2(0.f, 0.f)};
+    std::vector<Mirror> asteroids, bullets;
+    b2Body* shipBody = nullptr;
+    float shipX = 0.f, shipY = 0.f;
+};
+
+bool Box2DPhysics::available() {
+    return true;
+}
+
+Box2DPhysics::Box2DPhysics() : impl(new Impl(*this)) {}
+
+Box2DPhysics::~Box2DPhysics() = default;
+
+void Box2DPhysics::step(World& world, float dt) {
+    AsteroidStore& as = world.asteroids;
+    BulletStore& bs = world.bullets;
+    impl->syncShip(world.player);
+    impl->syncStore(as, impl->asteroids, BodyKind::Asteroid, [&](size_t i) { return as.radius[i]; });
+    impl->syncStore(bs, impl->bullets, BodyKind::Bullet, [&](size_t) { return bs.radius; });
+
+    hits.clear();
+    shipContacts.clear();
+    impl->world.Step(dt, VELOCITY_ITERATIONS, POSITION_ITERATIONS);
+
+    impl->readShip(world.player);
+    impl->readStore(as, impl->asteroids, [&](size_t i) { return as.radius[i]; });
+    impl->readStore(bs, impl->bullets, [&](size_t) { return bs.wrapMargin; });
+
+    // el mismo par puede anotarse en el paso normal y en el de impacto (CCD)
+    std::sort(hits.begin(), hits.end(), [](const BulletHit& l, const BulletHit& r) {
+        return l.bullet != r.bullet ? l.bullet < r.bullet : l.asteroid < r.asteroid;
+    });
+    hits.erase(std::unique(hits.begin(), hits.end(), [](const BulletHit& l, const BulletHit& r) {
+        return l.bullet == r.bullet && l.asteroid == r.asteroid;
+    }), hits.end());
+    std::sort(shipContacts.begin(), shipContacts.end());
+    shipContacts.erase(std::unique(shipContacts.begin(), shipContacts.end()), shipContacts.end());
+}
+
+size_t Box2DPhysics::bodyCount() const {
+    return (size_t)impl->world.GetBodyCount();
+}
+
+#else
+
+// Sin Box2D: la clase existe para que World y las herramientas compilen igual.
+struct Box2DPhysics::Impl {};
+
+bool Box2DPhysics::available() {
+    return false;
+}
+
+Box2DPhysics::Box2DPhysics() {}
+
+Box2DPhysics::~Box2DPhysics() = default;
+
+void Box2DPhysics::step(World&, float) {}
+
+size_t Box2DPhysics::bodyCount() const {
+    return 0;
+}
+
+#endif
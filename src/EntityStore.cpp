@@ -0,0 +1,184 @@
+#include "EntityStore.hpp"
+#include "SimdKernels.hpp"
+#include <algorithm>
+#include <functional>
+
+// La lista libre es un montículo de mínimos: siempre se reutiliza el slot más
+// bajo, así las entidades quedan juntas al principio de los arreglos.
+static int popFreeSlot(std::vector<std::uint32_t>& freeList, size_t& top, size_t capacity) {
+    if (!freeList.empty()) {
+        std::pop_heap(freeList.begin(), freeList.end(), std::greater<std::uint32_t>());
+        std::uint32_t slot = freeList.back();
+        freeList.pop_back();
+        return (int)slot;
+    }
+    if (top < capacity) return (int)top++;
+    return -1;
+}
+
+// Como la lista se vacía siempre por el mínimo, basta con qué slots están
+// libres (no en qué orden se liberaron) para repetir las mismas altas.
+static void rebuildFreeSlots(std::vector<std::uint32_t>& freeList, size_t& top, size_t& used,
+                             const std::vector<std::uint8_t>& alive, size_t count) {
+    freeList.clear();
+    top = count;
+    used = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (alive[i]) used++;
+        else freeList.push_back((std::uint32_t)i);
+    }
+    // ya ordenada de menor a mayor: es un montículo de mínimos válido
+    if (used == 0) { freeList.clear(); top = 0; }
+}
+
+static void pushFreeSlot(std::vector<std::uint32_t>& freeList, size_t& top, size_t& used, std::uint32_t slot) {
+    used--;
+    if (used == 0) { // pool vacío: volver a empezar desde el slot 0
+        freeList.clear();
+        top = 0;
+        return;
+    }
+    freeList.push_back(slot);
+    std::push_heap(freeList.begin(), freeList.end(), std::greater<std::uint32_t>());
+}
+
+// ---------------------------------------------------------------- balas
+
+void BulletStore::init(size_t capacity) {
+    x.assign(capacity, 0.f); y.assign(capacity, 0.f);
+    prevX.assign(capacity, 0.f); prevY.assign(capacity, 0.f);
+    vx.assign(capacity, 0.f); vy.assign(capacity, 0.f);
+    lifetime.assign(capacity, 0.f);
+    alive.assign(capacity, 0);
+    generation.assign(capacity, 0);
+    freeList.reserve(capacity);
+    clear();
+}
+
+void BulletStore::clear() {
+    std::fill(alive.begin(), alive.end(), 0);
+    freeList.clear();
+    top = 0;
+    used = 0;
+}
+
+int BulletStore::spawn(const Bullet& b) {
+    int slot = popFreeSlot(freeList, top, capacity());
+    if (slot < 0) return -1;
+    x[slot] = b.position.x; y[slot] = b.position.y;
+    prevX[slot] = b.prevPosition.x; prevY[slot] = b.prevPosition.y;
+    vx[slot] = b.velocity.x; vy[slot] = b.velocity.y;
+    lifetime[slot] = b.lifetime;
+    alive[slot] = 1;
+    generation[slot]++;
+    used++;
+    return slot;
+}
+
+void BulletStore::release(std::uint32_t slot) {
+    alive[slot] = 0;
+    pushFreeSlot(freeList, top, used, slot);
+}
+
+void BulletStore::resetSlots(size_t count) {
+    std::fill(alive.begin() + count, alive.end(), 0);
+    rebuildFreeSlots(freeList, top, used, alive, count);
+}
+
+Bullet BulletStore::get(size_t i) const {
+    Bullet b;
+    b.position = {x[i], y[i]};
+    b.prevPosition = {prevX[i], prevY[i]};
+    b.velocity = {vx[i], vy[i]};
+    b.lifetime = lifetime[i];
+    b.radius = radius;
+    b.alive = alive[i] != 0;
+    return b;
+}
+
+size_t BulletStore::update(float dt, float width, float height, std::uint32_t* expired) {
+    size_t n = tickLifetimes(dt, expired);
+    integrate(dt, width, height, 0, top);
+    return n;
+}
+
+size_t BulletStore::tickLifetimes(float dt, std::uint32_t* expired) {
+    return ::tickLifetimes(lifetime.data(), alive.data(), top, dt, expired);
+}
+
+void BulletStore::integrate(float dt, float width, float height, size_t begin, size_t end) {
+    if (begin >= end) return;
+    std::copy(x.begin() + begin, x.begin() + end, prevX.begin() + begin);
+    std::copy(y.begin() + begin, y.begin() + end, prevY.begin() + begin);
+    integrateWrapUniform(x.data() + begin, y.data() + begin, vx.data() + begin, vy.data() + begin,
+                         wrapMargin, end - begin, dt, width, height);
+}
+
+// ---------------------------------------------------------------- asteroides
+
+void AsteroidStore::init(size_t capacity) {
+    x.assign(capacity, 0.f); y.assign(capacity, 0.f);
+    prevX.assign(capacity, 0.f); prevY.assign(capacity, 0.f);
+    vx.assign(capacity, 0.f); vy.assign(capacity, 0.f);
+    radius.assign(capacity, 0.f);
+    size.assign(capacity, 0);
+    alive.assign(capacity, 0);
+    generation.assign(capacity, 0);
+    freeList.reserve(capacity);
+    clear();
+}
+
+void AsteroidStore::clear() {
+    std::fill(alive.begin(), alive.end(), 0);
+    freeList.clear();
+    top = 0;
+    used = 0;
+}
+
+int AsteroidStore::spawn(const Asteroid& a) {
+    int slot = popFreeSlot(freeList, top, capacity());
+    if (slot < 0) return -1;
+    x[slot] = a.position.x; y[slot] = a.position.y;
+    prevX[slot] = a.prevPosition.x; prevY[slot] = a.prevPosition.y;
+    vx[slot] = a.velocity.x; vy[slot] = a.velocity.y;
+    radius[slot] = a.radius;
+    size[slot] = (std::int8_t)a.size;
+    alive[slot] = 1;
+    generation[slot]++;
+    used++;
+    return slot;
+}
+
+void AsteroidStore::release(std::uint32_t slot) {
+    alive[slot] = 0;
+    pushFreeSlot(freeList, top, used, slot);
+}
+
+void AsteroidStore::resetSlots(size_t count) {
+    std::fill(alive.begin() + count, alive.end(), 0);
+    rebuildFreeSlots(freeList, top, used, alive, count);
+}
+
+Asteroid AsteroidStore::get(size_t i) const {
+    Asteroid a;
+    a.position = {x[i], y[i]};
+    a.prevPosition = {prevX[i], prevY[i]};
+    a.velocity = {vx[i], vy[i]};
+    a.radius = radius[i];
+    a.size = size[i];
+    a.sprite = sprite;
+    a.alive = alive[i] != 0;
+    return a;
+}
+
+void AsteroidStore::update(float dt, float width, float height) {
+    integrate(dt, width, height, 0, top);
+}
+
+void AsteroidStore::integrate(float dt, float width, float height, size_t begin, size_t end) {
+    if (begin >= end) return;
+    std::copy(x.begin() + begin, x.begin() + end, prevX.begin() + begin);
+    std::copy(y.begin() + begin, y.begin() + end, prevY.begin() + begin);
+    integrateWrap(x.data() + begin, y.data() + begin, vx.data() + begin, vy.data() + begin, radius.data() + begin,
+                  end - begin, dt, width, height);
+}
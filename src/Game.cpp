@@ -1,113 +1,475 @@
 #include "Game.hpp"
 #include <cmath>
+#include <cstdio>
 #include <cstdlib>
 #include <ctime>
-#include <sstream>
 #include <algorithm>
+#include "WorldSize.hpp"
+#include "Autopilot.hpp"
+
+// Vista del mundo completo dentro de una ventana de `pixels`: misma escala en
+// los dos ejes y bandas negras en el lado que sobre.
+static sf::View letterboxView(sf::Vector2u pixels) {
+    sf::View view(sf::FloatRect(0.f, 0.f, WORLD_WIDTH, WORLD_HEIGHT));
+    if (pixels.x == 0 || pixels.y == 0) return view;
+    const float windowRatio = pixels.x / (float)pixels.y;
+    const float worldRatio = WORLD_WIDTH / WORLD_HEIGHT;
+    sf::FloatRect viewport(0.f, 0.f, 1.f, 1.f);
+    if (windowRatio > worldRatio) {
+        viewport.width = worldRatio / windowRatio;
+        viewport.left = (1.f - viewport.width) / 2.f;
+    } else {
+        viewport.height = windowRatio / worldRatio;
+        viewport.top = (1.f - viewport.height) / 2.f;
+    }
+    view.setViewport(viewport);
+    return view;
+}
 
-int WIDTH = 1280;
-int HEIGHT = 720;
+// Píxeles que ocupa la vista en una ventana de `pixels`.
+static sf::Vector2u viewportPixels(const sf::View& view, sf::Vector2u pixels) {
+    const sf::FloatRect& vp = view.getViewport();
+    return sf::Vector2u((unsigned)(vp.width * pixels.x + 0.5f), (unsigned)(vp.height * pixels.y + 0.5f));
+}
 
-Game::Game(): player() {
-    // Fijar resolución a 1280x720 en modo ventana
-    WIDTH = 1280;
-    HEIGHT = 720;
-    window.create(sf::VideoMode(WIDTH, HEIGHT), "ASTEROIDS", sf::Style::Default);
+Game::Game() {
+    // Ventana de 1280x720 por defecto; el mundo se ajusta a cualquier tamaño (ver letterboxView)
+    window.create(sf::VideoMode((unsigned)WORLD_WIDTH, (unsigned)WORLD_HEIGHT), "ASTEROIDS", sf::Style::Default);
     window.setFramerateLimit(60);
-    // intentar cargar una fuente (opcional)
-    if (font.loadFromFile("assets/arial.ttf")) {
-        hud.setFont(font);
-        hud.setCharacterSize(18);
-        hud.setFillColor(sf::Color::White);
-    }
-    // intentar cargar algunas texturas de ejemplo - si estos archivos no existen
-    // el juego seguirá dibujando formas simples en lugar de fallar.
-    const sf::Texture* t = nullptr;
-    t = loadTexture("ship", "assets/imagenes/ship.png");
-    if (t) player.texture = t;
-
-    // textura de asteroide (compartida)
-    loadTexture("asteroid", "assets/asteroid_2.png");
-
-    // textura opcional de bala
-    loadTexture("bullet", "assets/imagenes/bullet.png");
-
-    // fondo para menú y partida
-    backgroundTexture = loadTexture("background", "assets/EspacioFondoJugando.jpg");
-
-    // textura de corazón para vidas
-    loadTexture("heart", "assets/imagenes/heart.png");
-
-    // inicializar semilla aleatoria
-    std::srand((unsigned)std::time(nullptr));
-
-    // inicializar música
-    loadMusicTracks();
-    playRandomTrack();
-    
-    // cargar sonido de disparo
-    if (shootSoundBuffer.loadFromFile("assets/Musica/disparonave.mp3")) {
-        shootSound.setBuffer(shootSoundBuffer);
-        shootSound.setVolume(musicVolume);
-    }
+    windowPixels = window.getSize();
+    setTickRate(tickRate);
+
+    // Con assets.pak (make pack) los recursos salen de un solo archivo mapeado
+    // y ya decodificado; si no está, se leen los archivos sueltos.
+    assets.mountPack("assets.pak");
+
+    // Todo lo que lee del disco se carga en hilos de fondo mientras run()
+    // muestra la pantalla de carga; al terminar, finishLoading() acomoda la
+    // interfaz. Si faltan archivos el juego sigue con formas simples.
+    // Nave, asteroide, bala y corazón van juntos en un atlas (una sola textura).
+    assets.queueSprite(SpriteId::Ship, "assets/imagenes/ship.png");
+    assets.queueSprite(SpriteId::Asteroid, "assets/asteroid_2.png");
+    assets.queueSprite(SpriteId::Bullet, "assets/imagenes/bullet.png");
+    assets.queueSprite(SpriteId::Heart, "assets/imagenes/heart.png");
+    // fondo para menú y partida (demasiado grande para el atlas)
+    backgroundHandle = assets.queueTexture("assets/EspacioFondoJugando.jpg");
+    // fuente (opcional)
+    assets.queueTask([this] { return assets.loadFont(font, "assets/arial.ttf"); },
+                     [this](bool ok) { fontLoaded = ok; });
+    // sonidos de disparo y de explosión de asteroide (opcionales)
+    assets.queueTask([this] { return assets.loadSound(shootSoundBuffer, "assets/Musica/disparonave.mp3"); },
+                     [this](bool ok) {
+                         if (ok) sfx.configure(Sfx::Shoot, &shootSoundBuffer, 1.f, 0, 4);
+                     });
+    assets.queueTask([this] { return assets.loadSound(explosionSoundBuffer, "assets/Musica/explosionasteroide.mp3"); },
+                     [this](bool ok) {
+                         // Hacer la explosión más suave respecto al volumen general, pero
+                         // con prioridad sobre los disparos si faltan voces
+                         if (ok) sfx.configure(Sfx::Explosion, &explosionSoundBuffer, 0.4f, 1, 6);
+                     });
+    assets.startLoading();
+
+    // semilla de la sesión: de aquí salen las semillas de cada partida
+    sessionRng.seed((std::uint64_t)std::time(nullptr));
+
+    // Las 7 canciones: solo se abren la que suena y la siguiente (ver MusicPlayer)
+    music.setTracks({
+        "assets/Musica/song1.mp3",
+        "assets/Musica/song2.mp3",
+        "assets/Musica/song3.mp3",
+        "assets/Musica/song4.mp3",
+        "assets/Musica/song5.mp3",
+        "assets/Musica/song6.mp3",
+        "assets/Musica/song7.mp3"
+    });
+    music.seed(sessionRng.next());
+    music.setPack(&assets.pack());
+    music.setVolume(musicVolume);
+    sfx.setVolume(musicVolume);
 
-    // cargar sonido de explosión de asteroide (opcional)
-    if (explosionSoundBuffer.loadFromFile("assets/Musica/explosionasteroide.mp3")) {
-        explosionSound.setBuffer(explosionSoundBuffer);
-        // Hacer la explosión más suave respecto al volumen general
-        explosionSound.setVolume(musicVolume * 0.4f);
-    }
+    world.profiler = &profiler;
+    setWorkerThreads(0);
+    particles.init(65536);
 
     // iniciar en estado de menú
     state = State::Menu;
 
-    resetLevel();
+    world.resetLevel();
+}
+
+Game::~Game() {
+    // las cargas en curso escriben en miembros de Game (fuente, sonidos, música)
+    assets.stopLoading();
+}
+
+void Game::finishLoading() {
+    assets.stopLoading();
+    world.player.sprite = assets.sprite(SpriteId::Ship);
+    world.asteroids.sprite = assets.sprite(SpriteId::Asteroid);
+    backgroundTexture = assets.texture(backgroundHandle);
+
+    // la interfaz se acomoda una sola vez
+    const sf::Font* uiFont = fontLoaded ? &font : nullptr;
+    hud.layout(uiFont, assets.sprite(SpriteId::Heart), WORLD_WIDTH, WORLD_HEIGHT);
+    menu.layout(uiFont, menuOptions, WORLD_WIDTH, WORLD_HEIGHT);
+    gameOverUi.layout(uiFont, WORLD_WIDTH, WORLD_HEIGHT);
+    backdrop.layout(backgroundTexture, WORLD_WIDTH, WORLD_HEIGHT);
+
+    music.start();
+}
+
+void Game::renderLoading() {
+    window.setView(letterboxView(windowPixels));
+    window.clear(sf::Color(10,10,30));
+    // barra de progreso sin texto: la fuente puede no estar cargada todavía
+    const sf::Vector2f size(WORLD_WIDTH * 0.4f, 12.f);
+    const sf::Vector2f pos((WORLD_WIDTH - size.x) / 2.f, (WORLD_HEIGHT - size.y) / 2.f);
+    batch.begin();
+    batch.addRect(pos - sf::Vector2f(2.f, 2.f), size + sf::Vector2f(4.f, 4.f), sf::Color(80,80,110));
+    batch.addRect(pos, size, sf::Color(20,20,40));
+    batch.addRect(pos, sf::Vector2f(size.x * assets.progress(), size.y), sf::Color(200,200,255));
+    batch.flush(window);
+    window.display();
+}
+
+void Game::setTickRate(float hz) {
+    tickRate = std::max(1.f, hz);
+    // un estado guardado cada 0.1 s, 10 s hacia atrás
+    const unsigned interval = (unsigned)std::max(1L, std::lround(tickRate * 0.1f));
+    rewind.configure(interval, (size_t)std::ceil(10.f * tickRate / interval));
+}
+
+void Game::setMaxCatchUpSteps(int steps) {
+    maxCatchUpSteps = std::max(1, steps);
+}
+
+void Game::setFrameLimit(unsigned fps) {
+    frameLimit = fps;
+    window.setFramerateLimit(fps);
+    window.setVerticalSyncEnabled(fps == 0);
+}
+
+void Game::setFullscreen(bool enabled) {
+    if (enabled == fullscreen) return;
+    fullscreen = enabled;
+    // recrear la ventana pierde el límite de FPS y el vsync
+    if (enabled) window.create(sf::VideoMode::getDesktopMode(), "ASTEROIDS", sf::Style::Fullscreen);
+    else window.create(sf::VideoMode((unsigned)WORLD_WIDTH, (unsigned)WORLD_HEIGHT), "ASTEROIDS", sf::Style::Default);
+    setFrameLimit(frameLimit);
+    windowPixels = window.getSize();
+}
+
+void Game::setDynamicResolution(float targetFps) {
+    renderBudget = targetFps > 0.f ? 1.f / targetFps : 0.f;
+    renderScale = 1.f;
+    renderSeconds = 0.f;
+}
+
+void Game::setProfileOutput(const std::string& path) {
+    profileOutput = path;
+    profiler.setRecording(!path.empty());
+}
+
+void Game::setRecordOutput(const std::string& path) {
+    recordPath = path;
+}
+
+bool Game::loadReplay(const std::string& path) {
+    if (!playback.load(path)) return false;
+    replaying = true;
+    playbackTick = 0;
+    setTickRate(1.f / playback.dt);
+    startGame();
+    return true;
+}
+
+void Game::setReplaySpeed(float speed) {
+    replaySpeed = std::max(0.1f, speed);
+}
+
+void Game::setWorkerThreads(unsigned count) {
+    world.jobs = nullptr;
+    jobs = std::make_unique<JobSystem>(count);
+    world.jobs = jobs.get();
 }
 
-const sf::Texture* Game::loadTexture(const std::string& id, const std::string& path) {
-    sf::Texture tex;
-    if (tex.loadFromFile(path)) {
-        textures[id] = std::move(tex);
-        return &textures[id];
+void Game::setRenderThread(bool enabled) {
+    renderThreaded = enabled;
+}
+
+bool Game::setBox2DPhysics(bool enabled) {
+    if (enabled && !Box2DPhysics::available()) return false;
+    world.physics = nullptr;
+    if (enabled) physics = std::make_unique<Box2DPhysics>();
+    else physics.reset();
+    world.physics = physics.get();
+    return true;
+}
+
+bool Game::hostGame(unsigned short port, float snapshotRate) {
+    client.reset();
+    server = std::make_unique<NetServer>();
+    if (server->start(port, tickRate, snapshotRate)) return true;
+    server.reset();
+    return false;
+}
+
+bool Game::joinGame(const std::string& host, unsigned short port) {
+    server.reset();
+    client = std::make_unique<NetClient>();
+    if (client->connect(host, port, tickRate)) return true;
+    client.reset();
+    return false;
+}
+
+void Game::setSessionFile(const std::string& path) {
+    sessionPath = path;
+}
+
+void Game::saveSession() {
+    if (!canRewind() || state != State::Playing) return;
+    // una escritura a la vez; la copia del estado es lo único que pasa en este frame
+    collectSessionSave(false);
+    if (sessionSaving.valid()) return;
+    auto saved = std::make_shared<WorldState>();
+    saved->capture(world);
+    sessionSaving = std::async(std::launch::async, [saved, path = sessionPath] { return saved->save(path); });
+}
+
+void Game::collectSessionSave(bool wait) {
+    if (!sessionSaving.valid()) return;
+    if (!wait && sessionSaving.wait_for(std::chrono::seconds(0)) != std::future_status::ready) return;
+    if (!sessionSaving.get()) std::printf("no se pudo escribir %s\n", sessionPath.c_str());
+}
+
+void Game::loadSession() {
+    if (!canRewind()) return;
+    // si se está escribiendo la misma partida, esperar a que termine
+    collectSessionSave(true);
+    WorldState saved;
+    if (!saved.load(sessionPath) || !saved.restore(world)) {
+        std::printf("no se pudo cargar %s\n", sessionPath.c_str());
+        return;
+    }
+    // la grabación empieza en la semilla: una partida cargada ya no se puede
+    // repetir, así que no se graba hasta la próxima startGame()
+    recording.inputs.clear();
+    recordingGame = false;
+    particles.clear();
+    rewind.reset(world);
+    state = world.isGameOver() ? State::GameOver : State::Playing;
+}
+
+void Game::setAutopilot(bool enabled) {
+    autopilot = enabled;
+}
+
+void Game::setSoak(const SoakLimits& limits) {
+    soakLimits = limits;
+    soaking = true;
+    autopilot = true;
+}
+
+void Game::startGame() {
+    // el cliente no empieza partidas: muestra la del anfitrión
+    if (client) {
+        state = State::Playing;
+        return;
     }
-    return nullptr;
+    std::uint64_t seed = replaying ? playback.seed : ((std::uint64_t)sessionRng.next() << 32 | sessionRng.next());
+    soakGames++;
+    world.seed(seed);
+    world.newGame();
+    particles.clear();
+    state = State::Playing;
+    recordingGame = !replaying && !recordPath.empty();
+    if (recordingGame) recording.begin(seed, 1.f / tickRate);
+    if (canRewind()) rewind.reset(world);
+}
+
+void Game::restartGame() {
+    if (world.isGameOver()) startGame();
+}
+
+void Game::finishGame() {
+    if (replaying) {
+        // misma huella = misma partida bit a bit
+        bool same = world.checksum() == playback.finalChecksum;
+        std::printf("repeticion: %zu ticks, huella %s\n", playbackTick, same ? "igual a la grabada" : "DISTINTA de la grabada");
+        replaying = false;
+        return;
+    }
+    if (recordingGame && recording.ticks() > 0) {
+        recording.finalChecksum = world.checksum();
+        if (!recording.save(recordPath)) std::printf("no se pudo escribir %s\n", recordPath.c_str());
+        recording.inputs.clear();
+    }
+}
+
+void Game::captureFrame(FrameSnapshot& f, float alpha, float tickSeconds) {
+    f.world.capture(world);
+    f.particles.copyFrom(particles);
+    f.state = state;
+    f.menuSelection = menuSelection;
+    f.musicVolume = musicVolume;
+    f.musicPlaying = music.isPlaying();
+    f.showDebug = showDebug;
+    f.windowPixels = windowPixels;
+    if (showDebug) f.profileText = profileText;
+    f.alpha = alpha;
+    f.tickSeconds = tickSeconds;
+    f.published = std::chrono::steady_clock::now();
 }
 
 void Game::run() {
+    // pantalla de carga hasta tener todos los recursos (texturas subidas en este hilo)
+    while (window.isOpen() && !quitRequested && !assets.poll()) {
+        sf::Event ev;
+        while (window.pollEvent(ev)) {
+            if (ev.type == sf::Event::Closed) quitRequested = true;
+            if (ev.type == sf::Event::Resized) windowPixels = sf::Vector2u(ev.size.width, ev.size.height);
+            if (ev.type == sf::Event::KeyPressed && ev.key.code == sf::Keyboard::Escape) quitRequested = true;
+        }
+        renderLoading();
+    }
+    if (!quitRequested) {
+        finishLoading();
+        profiler.markStartup();
+    }
+    if (soaking && !quitRequested) {
+        soak.begin(soakLimits);
+        if (state == State::Menu) startGame();
+    }
+
     sf::Clock clock;
-    while (window.isOpen()) {
-        float dt = clock.restart().asSeconds();
-        processEvents();
-        update(dt);
-        render();
+    float accumulator = 0.f;
+    if (renderThreaded && !quitRequested) {
+        // el contexto de OpenGL de la ventana pasa al hilo de dibujo; los
+        // eventos se siguen leyendo aquí (SFML lo exige en el hilo que la creó)
+        captureFrame(frames.back(), 0.f, 1.f / tickRate);
+        frames.publish();
+        window.setActive(false);
+        rendering = true;
+        renderThread = std::thread(&Game::renderLoop, this);
+    }
+    while (window.isOpen() && !quitRequested) {
+        profiler.beginFrame();
+        const float tickDt = 1.f / tickRate;
+        const float frameDt = clock.restart().asSeconds();
+        // una repetición puede ir más rápido que el tiempo real
+        const float speed = replaying ? replaySpeed : 1.f;
+        const int maxSteps = std::max(1, (int)(maxCatchUpSteps * speed));
+        accumulator += frameDt * speed;
+        {
+            ProfileScope zone(&profiler, ProfileZone::Events);
+            processEvents();
+        }
+        {
+            ProfileScope zone(&profiler, ProfileZone::Update);
+            {
+                ProfileScope musicZone(&profiler, ProfileZone::Music);
+                music.update(frameDt);
+            }
+
+            // Paso fijo: tantos ticks como quepan en el tiempo acumulado
+            int steps = 0;
+            while (accumulator >= tickDt && steps < maxSteps) {
+                if (soaking) {
+                    auto t0 = std::chrono::steady_clock::now();
+                    tick(tickDt);
+                    soak.addTick(std::chrono::duration<float>(std::chrono::steady_clock::now() - t0).count());
+                } else {
+                    tick(tickDt);
+                }
+                accumulator -= tickDt;
+                steps++;
+            }
+            // Si vamos demasiado atrasados, descartar el resto en vez de acumular más trabajo
+            if (steps == maxSteps && accumulator >= tickDt) accumulator = 0.f;
+        }
+
+        if (soaking) {
+            soak.addFrame(frameDt);
+            if (!soak.poll(world, soakGames)) {
+                soakOk = soak.finish();
+                soaking = false;
+                quitRequested = true;
+            }
+        }
+
+        // la tabla del overlay cambia pocas veces por segundo para que se pueda leer
+        profileRefresh += frameDt;
+        if (showDebug && profileRefresh >= 0.25f) {
+            profileText = profiler.table();
+            if (server) profileText += server->describe();
+            if (client) profileText += client->describe() + "\n";
+            profileRefresh = 0.f;
+        }
+
+        if (renderThreaded) {
+            captureFrame(frames.back(), accumulator / tickDt, tickDt / speed);
+            frames.publish();
+            profiler.endFrame();
+            // dormir hasta el siguiente tick; el hilo de dibujo lleva su propio ritmo
+            float wait = (tickDt - accumulator) / speed;
+            if (wait > 0.f) std::this_thread::sleep_for(std::chrono::duration<float>(wait));
+            continue;
+        }
+
+        {
+            ProfileScope zone(&profiler, ProfileZone::Render);
+            captureFrame(frame, accumulator / tickDt, tickDt / speed);
+            render(frame, frame.alpha);
+        }
+        profiler.endFrame();
+    }
+    if (renderThread.joinable()) {
+        rendering = false;
+        renderThread.join();
+        window.setActive(true);
+    }
+    window.close();
+    collectSessionSave(true);
+    if (state == State::Playing) finishGame();
+    if (!profileOutput.empty()) profiler.write(profileOutput);
+}
+
+void Game::renderLoop() {
+    window.setActive(true);
+    while (rendering.load(std::memory_order_acquire)) {
+        frames.acquire();
+        const FrameSnapshot& f = frames.front();
+        // seguir interpolando con el tiempo que pasó desde que se publicó
+        float since = std::chrono::duration<float>(std::chrono::steady_clock::now() - f.published).count();
+        render(f, std::min(1.f, f.alpha + since / f.tickSeconds));
     }
+    window.setActive(false);
 }
 
 void Game::processEvents() {
+    collectSessionSave(false);
     sf::Event ev;
     while (window.pollEvent(ev)) {
-        if (ev.type == sf::Event::Closed) window.close();
+        if (ev.type == sf::Event::Closed) quitRequested = true;
+        if (ev.type == sf::Event::Resized) windowPixels = sf::Vector2u(ev.size.width, ev.size.height);
         if (ev.type == sf::Event::KeyPressed) {
             if (ev.key.code == sf::Keyboard::Escape) {
-                window.close();
+                quitRequested = true;
             }
+            if (ev.key.code == sf::Keyboard::F3) showDebug = !showDebug;
+            if (ev.key.code == sf::Keyboard::F5) saveSession();
+            if (ev.key.code == sf::Keyboard::F9) loadSession();
             // Controles de volumen
             if (ev.key.code == sf::Keyboard::Up && ev.key.shift) {
                 musicVolume = std::min(100.f, musicVolume + 5.f);
-                if (currentTrackIndex >= 0 && currentTrackIndex < (int)musicTracks.size()) {
-                    musicTracks[currentTrackIndex]->setVolume(musicVolume);
-                }
+                music.setVolume(musicVolume);
                 // actualizar sonidos cortos
-                shootSound.setVolume(musicVolume);
-                explosionSound.setVolume(musicVolume * 0.4f);
+                sfx.setVolume(musicVolume);
             } else if (ev.key.code == sf::Keyboard::Down && ev.key.shift) {
                 musicVolume = std::max(0.f, musicVolume - 5.f);
-                if (currentTrackIndex >= 0 && currentTrackIndex < (int)musicTracks.size()) {
-                    musicTracks[currentTrackIndex]->setVolume(musicVolume);
-                }
+                music.setVolume(musicVolume);
                 // actualizar sonidos cortos
-                shootSound.setVolume(musicVolume);
-                explosionSound.setVolume(musicVolume * 0.4f);
+                sfx.setVolume(musicVolume);
             }
             if (state == State::Menu) {
                 if (ev.key.code == sf::Keyboard::Up || ev.key.code == sf::Keyboard::W) {
@@ -117,18 +479,14 @@ void Game::processEvents() {
                 } else if (ev.key.code == sf::Keyboard::Enter || ev.key.code == sf::Keyboard::Space) {
                     if (menuSelection == 0) {
                         // Jugar
-                        score = 0; lives = 3; elapsedTime = 0.f; asteroidTimer = 0.f;
-                        resetLevel();
-                        state = State::Playing;
+                        startGame();
                     } else {
                         // Salir
-                        window.close();
+                        quitRequested = true;
                     }
                 }
             } else {
-                if (ev.key.code == sf::Keyboard::R && lives<=0) {
-                    score = 0; lives = 3; elapsedTime = 0.f; asteroidTimer = 0.f; resetLevel(); state = State::Playing;
-                }
+                if (ev.key.code == sf::Keyboard::R) restartGame();
                 // Volver al menú desde GameOver
                 if (ev.key.code == sf::Keyboard::M && state == State::GameOver) {
                     state = State::Menu;
@@ -137,575 +495,261 @@ void Game::processEvents() {
             }
         }
 
-        // Manejo del ratón en el menú: pasar por encima y clic
+        // Manejo del ratón en el menú: pasar por encima y clic (zonas calculadas en el layout)
+        // (las zonas están en unidades del mundo: el ratón se pasa por la misma vista)
         if (ev.type == sf::Event::MouseMoved && state == State::Menu) {
-            sf::Vector2i mpos = sf::Mouse::getPosition(window);
-            // calcular rectángulos de opciones de menú y detectar si el cursor está encima
-            float spacing = 72.f; // espacio aumentado
-            for (size_t i=0;i<menuOptions.size();++i) {
-                if (font.getInfo().family != "") {
-                    sf::Text opt(menuOptions[i], font, 32);
-                    auto ob = opt.getLocalBounds();
-                    float x = WIDTH/2.f - ob.width/2.f;
-                    float y = HEIGHT*0.5f + (float)i*spacing - ob.height/2.f;
-                    sf::FloatRect r(x, y, ob.width, ob.height + 8.f);
-                    if (r.contains((float)mpos.x, (float)mpos.y)) {
-                        menuSelection = (int)i;
-                        break;
-                    }
-                } else {
-                    // rectángulo alternativo
-                    float w = 220.f, h = 44.f;
-                    float x = WIDTH/2.f - w/2.f;
-                    float y = HEIGHT*0.5f + (float)i*spacing - h/2.f;
-                    sf::FloatRect r(x,y,w,h);
-                    if (r.contains((float)mpos.x, (float)mpos.y)) { menuSelection = (int)i; break; }
-                }
-            }
+            sf::Vector2i pixel(ev.mouseMove.x, ev.mouseMove.y);
+            int hit = menu.hitTest(window.mapPixelToCoords(pixel, letterboxView(windowPixels)));
+            if (hit >= 0) menuSelection = hit;
         }
 
-        if (ev.type == sf::Event::MouseButtonPressed && state == State::Menu) {
-            if (ev.mouseButton.button == sf::Mouse::Left) {
-                sf::Vector2i mpos = sf::Mouse::getPosition(window);
-                float spacing = 72.f;
-                for (size_t i=0;i<menuOptions.size();++i) {
-                    if (font.getInfo().family != "") {
-                        sf::Text opt(menuOptions[i], font, 32);
-                        auto ob = opt.getLocalBounds();
-                        float x = WIDTH/2.f - ob.width/2.f;
-                        float y = HEIGHT*0.5f + (float)i*spacing - ob.height/2.f;
-                        sf::FloatRect r(x, y, ob.width, ob.height + 8.f);
-                        if (r.contains((float)mpos.x, (float)mpos.y)) {
-                            if (i==0) { score = 0; lives = 3; elapsedTime = 0.f; asteroidTimer = 0.f; resetLevel(); state = State::Playing; }
-                            else { window.close(); }
-                        }
-                    } else {
-                        float w = 220.f, h = 44.f;
-                        float x = WIDTH/2.f - w/2.f;
-                        float y = HEIGHT*0.5f + (float)i*spacing - h/2.f;
-                        sf::FloatRect r(x,y,w,h);
-                        if (r.contains((float)mpos.x, (float)mpos.y)) {
-                            if (i==0) { score = 0; lives = 3; elapsedTime = 0.f; asteroidTimer = 0.f; resetLevel(); state = State::Playing; }
-                            else { window.close(); }
-                        }
-                    }
-                }
-            }
-        }
-        
-        // Manejador de clics en la barra de volumen y botones de música
         if (ev.type == sf::Event::MouseButtonPressed && ev.mouseButton.button == sf::Mouse::Left) {
-            sf::Vector2i mpos = sf::Mouse::getPosition(window);
-            // Barra de volumen
-            if (volumeBarRect.contains((float)mpos.x, (float)mpos.y)) {
-                // Calcular el nuevo volumen basado en la posición del clic
-                float relativeX = (float)mpos.x - volumeBarRect.left;
-                musicVolume = (relativeX / volumeBarRect.width) * 100.f;
-                musicVolume = std::max(0.f, std::min(100.f, musicVolume));
-                
-                // Actualizar volumen de la música actual
-                if (currentTrackIndex >= 0 && currentTrackIndex < (int)musicTracks.size()) {
-                    musicTracks[currentTrackIndex]->setVolume(musicVolume);
-                }
-                
-                // Actualizar volumen del sonido de disparo
-                shootSound.setVolume(musicVolume);
-                explosionSound.setVolume(musicVolume * 0.4f);
+            sf::Vector2i pixel(ev.mouseButton.x, ev.mouseButton.y);
+            sf::Vector2f mpos = window.mapPixelToCoords(pixel, letterboxView(windowPixels));
+            if (state == State::Menu) {
+                int hit = menu.hitTest(mpos);
+                if (hit == 0) { startGame(); }
+                else if (hit > 0) { quitRequested = true; }
+                continue;
             }
-            // Botones: anterior / play-pause / siguiente
-            else if (prevButtonRect.contains((float)mpos.x, (float)mpos.y)) {
-                playPrevTrack();
-            } else if (playPauseButtonRect.contains((float)mpos.x, (float)mpos.y)) {
-                toggleMusicPlayPause();
-            } else if (nextButtonRect.contains((float)mpos.x, (float)mpos.y)) {
-                playNextTrack();
+            // Barra de volumen y botones de música del HUD
+            switch (hud.hitTest(mpos)) {
+                case HudControl::VolumeBar:
+                    // Calcular el nuevo volumen basado en la posición del clic
+                    musicVolume = hud.volumeAt(mpos.x);
+                    music.setVolume(musicVolume);
+                    sfx.setVolume(musicVolume);
+                    break;
+                case HudControl::PrevTrack: music.prev(); break;
+                case HudControl::PlayPause: music.togglePause(); break;
+                case HudControl::NextTrack: music.next(); break;
+                case HudControl::None: break;
             }
         }
     }
 }
 
-void Game::update(float dt) {
-
-    // Actualizar música
-    updateMusic();
-    
-    if (lives <= 0) return; // fin del juego: esperar reinicio
-
-    // registro de tiempo usado para ajustar la dificultad
-    elapsedTime += dt;
-    timeSinceLastShot += dt;
-    asteroidTimer += dt;
-
-    player.handleInput();
-    // disparo (enfriamiento manejado por el temporizador de Game)
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Space) && timeSinceLastShot >= 0.18f) {
-        bullets.push_back(player.shoot());
-        timeSinceLastShot = 0.f;
-        // Reproducir sonido de disparo
-        shootSound.setVolume(musicVolume);
-        explosionSound.setVolume(musicVolume * 0.4f);
-        shootSound.play();
-    }
+ShipInput Game::readInput() const {
+    if (autopilot) return autopilotInput(world, world.player);
+    ShipInput in;
+    in.left = sf::Keyboard::isKeyPressed(sf::Keyboard::Left);
+    in.right = sf::Keyboard::isKeyPressed(sf::Keyboard::Right);
+    in.thrust = sf::Keyboard::isKeyPressed(sf::Keyboard::Up);
+    in.shoot = sf::Keyboard::isKeyPressed(sf::Keyboard::Space);
+    return in;
+}
 
-    player.update(dt);
-    player.update(dt);
-
-    // actualizar balas
-    for (auto& b : bullets) b.update(dt);
-    bullets.erase(std::remove_if(bullets.begin(), bullets.end(), [](const Bullet& b){return !b.alive;}), bullets.end());
-
-    // actualizar asteroides
-    for (auto& a : asteroids) a.update(dt);
-    asteroids.erase(std::remove_if(asteroids.begin(), asteroids.end(), [](const Asteroid& a){return !a.alive;}), asteroids.end());
-
-    // colisiones: balas vs asteroides
-    for (auto& b : bullets) {
-        for (auto& a : asteroids) {
-            if (!b.alive || !a.alive) continue;
-            if (circleCollision(b.position, b.radius, a.position, a.radius)) {
-                b.alive = false;
-                a.alive = false;
-                score += 100 * (a.size+1);
-                if (explosionSound.getBuffer()) explosionSound.play();
-                // dividir en asteroides más pequeños
-                if (a.size > 0) {
-                    for (int i=0;i<2;i++) {
-                        Asteroid child = a;
-                        child.size = a.size - 1;
-                        child.radius = a.radius*0.6f;
-                        float ang = (std::rand()%360) * 3.14159f/180.f;
-                        float speed = 50.f + std::rand()%100;
-                        child.velocity = {std::cos(ang)*speed, std::sin(ang)*speed};
-                        child.alive = true;
-                        asteroids.push_back(child);
-                    }
-                }
-            }
+void Game::tick(float dt) {
+    // las partículas siguen cayendo también en la pantalla de fin de juego
+    particles.update(dt);
+    // en red la partida sigue en la pantalla de fin de juego: el anfitrión
+    // atiende a los clientes y el cliente espera a que el anfitrión reinicie
+    // el piloto automático vuelve a jugar por el mismo camino que la R
+    if (autopilot && state == State::GameOver && !client) restartGame();
+    const bool networked = (server || client) && state != State::Menu;
+    if (state != State::Playing && !networked) return;
+
+    ShipInput in;
+    if (state != State::Playing) {
+        // sin entrada hasta la próxima partida
+    } else if (replaying) {
+        // la repetición terminó sin fin de juego (se grabó hasta cerrar la ventana)
+        if (playbackTick >= playback.ticks()) {
+            finishGame();
+            state = State::Menu;
+            return;
         }
+        in = playback.input(playbackTick++);
+        dt = playback.dt; // el dt grabado, bit a bit
+    } else if (canRewind() && sf::Keyboard::isKeyPressed(sf::Keyboard::Backspace)) {
+        // mantener Retroceso rebobina un estado guardado por tick (unas 6 veces
+        // más rápido que el juego); la grabación vuelve al mismo tick
+        long long restored = rewind.rewind(world, 1);
+        if (restored >= 0 && recording.ticks() > (size_t)restored) recording.inputs.resize((size_t)restored);
+        return;
+    } else {
+        in = readInput();
+        if (recordingGame && !client) recording.record(in);
     }
-
-    // nave vs asteroide
-    for (auto& a : asteroids) {
-        if (!a.alive || !player.alive) continue;
-        if (circleCollision(player.position, player.radius, a.position, a.radius)) {
-            player.alive = false;
-            // Daño: 1 vida hasta 15000 puntos; a partir de 1500, el impacto hace 2 de daño
-            int daño = (score >= 15000) ? 2 : 1;
-
-            lives -= daño;
-            if (lives>0) {
-                player.reset(sf::Vector2f(WIDTH/2.f, HEIGHT/2.f));
-                player.alive = true;
-            } else {
-                // sin vidas -> estado GameOver
-                if (score > maxScore) {
-                    maxScore = score;
-                }
-                state = State::GameOver;
-            }
-            break;
+    if (client) {
+        client->update(world, in);
+        if (client->timedOut()) {
+            std::printf("sin respuesta del servidor: %s\n", client->describe().c_str());
+            client.reset();
+            state = State::Menu;
+            return;
         }
+    } else {
+        if (server) server->receive(world);
+        world.step(dt, in);
+        if (server) server->send(world);
+        else if (canRewind()) rewind.record(world);
     }
-
-    // generar más asteroides si se han eliminado todos
-    if (asteroids.empty()) {
-        // aumentar la cantidad inicial lentamente con el tiempo
-        unsigned base = 4u;
-        unsigned extra = static_cast<unsigned>(elapsedTime / 20.0f); // +1 cada 20s
-        spawnAsteroids(base + extra);
+    emitEffects();
+
+    // Reproducir sonidos de lo ocurrido en el tick: un disparo de voz por efecto
+    if (world.shotsFired > 0) sfx.trigger(Sfx::Shoot, (unsigned)world.shotsFired);
+    if (world.asteroidsDestroyed > 0) sfx.trigger(Sfx::Explosion, (unsigned)world.asteroidsDestroyed);
+    sfx.flush();
+
+    // sin vidas -> estado GameOver (el cliente vuelve a jugar cuando el anfitrión reinicia)
+    if (world.isGameOver() && state == State::Playing) {
+        state = State::GameOver;
+        finishGame();
+    } else if (!world.isGameOver() && client) {
+        state = State::Playing;
     }
+}
 
-    // Generación periódica: conforme avanza el juego, el intervalo entre generados se acorta, aumentando la dificultad.
-    float spawnInterval = std::max(1.0f, 5.0f - elapsedTime / 60.0f); // de 5s hasta mínimo 1s
-    if (asteroidTimer > spawnInterval) {
-        // generar una pequeña cantidad escalada por el tiempo
-        unsigned count = 1 + static_cast<unsigned>(elapsedTime / 60.0f);
-        spawnAsteroids(count);
-        asteroidTimer = 0.f;
+void Game::emitEffects() {
+    for (const World::Explosion& e : world.explosions) {
+        ParticleSystem::Burst b;
+        b.origin = e.position;
+        b.baseVelocity = e.velocity * 0.5f;
+        if (e.ship) {
+            b.minSpeed = 60.f; b.maxSpeed = 320.f;
+            b.minLife = 0.6f; b.maxLife = 1.4f;
+            b.size = 3.f;
+            b.color = sf::Color(150,220,255);
+            particles.emit(b, 160);
+        } else {
+            // restos en proporción al tamaño del asteroide
+            b.minSpeed = 30.f; b.maxSpeed = 180.f;
+            b.minLife = 0.3f; b.maxLife = 0.9f;
+            b.size = 2.5f;
+            b.color = sf::Color(200,180,150);
+            particles.emit(b, 8 + (unsigned)(e.radius * 0.6f));
+        }
     }
+    // estela del motor: sale por detrás de cada nave mientras empuja
+    auto exhaust = [&](const Ship& ship) {
+        if (!ship.alive || !ship.thrusting) return;
+        float rad = ship.angle * 3.14159f/180.f;
+        ParticleSystem::Burst b;
+        b.origin = ship.position - sf::Vector2f(std::cos(rad), std::sin(rad)) * ship.radius;
+        b.baseVelocity = ship.velocity;
+        b.angle = ship.angle + 180.f;
+        b.spread = 12.f;
+        b.minSpeed = 120.f; b.maxSpeed = 220.f;
+        b.minLife = 0.15f; b.maxLife = 0.35f;
+        b.size = 2.f;
+        b.color = sf::Color(255,170,60);
+        particles.emit(b, 3);
+    };
+    exhaust(world.player);
+    for (const World::Guest& g : world.guests) exhaust(g.ship);
 }
 
-void Game::render() {
+void Game::render(const FrameSnapshot& f, float alpha) {
+    const WorldSnapshot& snap = f.world;
+    // el perfilador no es seguro entre hilos: con hilo de dibujo solo mide la simulación
+    Profiler* zones = renderThreaded ? nullptr : &profiler;
+    const auto renderStart = std::chrono::steady_clock::now();
+    lastDrawCalls = drawCalls;
+    drawCalls = 0;
+    // el mundo siempre mide WORLD_WIDTH x WORLD_HEIGHT; la vista lo ajusta a la ventana
+    const sf::View view = letterboxView(f.windowPixels);
+    const sf::Vector2u scenePixels = viewportPixels(view, f.windowPixels);
+    window.setView(view);
     window.clear(sf::Color::Black);
 
-    // Si está en Menú, dibujar fondo y opciones
-    if (state == State::Menu) {
-        if (backgroundTexture) {
-            sf::Sprite bg(*backgroundTexture);
-            auto tx = backgroundTexture->getSize();
-            float sx = (float)WIDTH / (float)tx.x;
-            float sy = (float)HEIGHT / (float)tx.y;
-            bg.setScale(sx, sy);
-            window.draw(bg);
-        } else {
-            // color de fondo alternativo
-            window.clear(sf::Color(10,10,30));
-        }
+    // estrellas: se mueven con el tiempo real del dibujo y la velocidad de la nave
+    backdrop.resize(scenePixels);
+    float frameDt = std::min(0.1f, backdropClock.restart().asSeconds());
+    bool flying = f.state == State::Playing && snap.player.alive;
+    backdrop.update(frameDt, flying ? snap.player.velocity : sf::Vector2f(0.f, 0.f));
 
-        if (font.getInfo().family != "") {
-            sf::Text title("Asteroides", font, 64);
-            title.setFillColor(sf::Color::Yellow);
-            auto tb = title.getLocalBounds();
-            title.setOrigin(tb.width/2.f, tb.height/2.f);
-            title.setPosition(WIDTH/2.f, HEIGHT*0.25f);
-            window.draw(title);
-
-            for (size_t i=0;i<menuOptions.size();++i) {
-                sf::Text opt(menuOptions[i], font, 32);
-                if ((int)i==menuSelection) opt.setFillColor(sf::Color::Yellow);
-                else opt.setFillColor(sf::Color::White);
-                auto ob = opt.getLocalBounds();
-                opt.setOrigin(ob.width/2.f, ob.height/2.f);
-                opt.setPosition(WIDTH/2.f, HEIGHT*0.5f + (float)i*48.f);
-                window.draw(opt);
-            }
-        }
+    // Si está en Menú, dibujar fondo (con el título ya pintado) y opciones
+    if (f.state == State::Menu) {
+        drawCalls += backdrop.drawMenu(window, menu);
+        menu.setSelection(f.menuSelection);
+        drawCalls += menu.draw(window);
 
         window.display();
         return;
     }
 
-    // Jugando o GameOver
-    // dibujar fondo para la partida
-    if (backgroundTexture) {
-        sf::Sprite bg(*backgroundTexture);
-        auto tx = backgroundTexture->getSize();
-        float sx = (float)WIDTH / (float)tx.x;
-        float sy = (float)HEIGHT / (float)tx.y;
-        bg.setScale(sx, sy);
-        window.draw(bg);
-    } else {
-        // fondo alternativo para la partida
-        // mantener el color limpio (negro) o dibujar un relleno oscuro sutil
+    // Con resolución dinámica la escena va a una textura aparte, a una fracción
+    // de los píxeles de la ventana, y se estira al presentarla; el HUD no se escala.
+    const bool scaled = renderBudget > 0.f && prepareSceneTarget(scenePixels);
+    sf::RenderTarget& scene = scaled ? (sf::RenderTarget&)sceneTarget : (sf::RenderTarget&)window;
+    if (scaled) {
+        sf::View sceneView(sf::FloatRect(0.f, 0.f, WORLD_WIDTH, WORLD_HEIGHT));
+        sceneView.setViewport(sf::FloatRect(0.f, 0.f, renderScale, renderScale));
+        sceneTarget.setView(sceneView);
+        sceneTarget.clear(sf::Color::Black);
     }
 
-    // dibujar balas
-    for (auto& b : bullets) b.draw(window);
-    // dibujar asteroides
-    for (auto& a : asteroids) a.draw(window);
-    // dibujar jugador
-    if (player.alive) player.draw(window);
-
-    // HUD: puntos y corazones para vidas
-    if (font.getInfo().family != "") {
-    std::ostringstream ss;
-    ss << "Puntos: " << score;
-        hud.setString(ss.str());
-        hud.setPosition(8.f, 8.f);
-        window.draw(hud);
-
-        // dibujar corazones en la esquina superior derecha
-        const float heartSize = 20.f;
-        for (int i=0;i<lives;i++) {
-            float x = WIDTH - 8.f - (i+1)*(heartSize+6.f);
-            float y = 8.f;
-            auto it = textures.find("heart");
-            if (it != textures.end()) {
-                sf::Sprite hs(it->second);
-                auto ts = it->second.getSize();
-                float sx = heartSize / (float)ts.x;
-                float sy = heartSize / (float)ts.y;
-                hs.setScale(sx, sy);
-                hs.setPosition(x, y);
-                window.draw(hs);
-            } else {
-                // alternativa: dibujar una forma de corazón simple usando ConvexShape
-                sf::ConvexShape heart;
-                heart.setPointCount(6);
-                float s = heartSize;
-                // los puntos aproximan un corazón centrado en (0,0)
-                heart.setPoint(0, sf::Vector2f(0.f, -s*0.15f));
-                heart.setPoint(1, sf::Vector2f(s*0.25f, -s*0.5f));
-                heart.setPoint(2, sf::Vector2f(s*0.5f, -s*0.15f));
-                heart.setPoint(3, sf::Vector2f(0.f, s*0.5f));
-                heart.setPoint(4, sf::Vector2f(-s*0.5f, -s*0.15f));
-                heart.setPoint(5, sf::Vector2f(-s*0.25f, -s*0.5f));
-                heart.setFillColor(sf::Color::Red);
-                // posicionarlo en el área superior derecha
-                heart.setPosition(x + heartSize/2.f, y + heartSize/2.f + 4.f);
-                // escalarlo un poco para que encaje bien
-                float scale = (heartSize / (s));
-                heart.setScale(scale, scale);
-                heart.setOrigin(0.f, 0.f);
-                window.draw(heart);
-            }
-        }
-        
-        // Dibujar barra de volumen debajo de los corazones
-        float barWidth = 100.f;
-        float barHeight = 8.f;
-        float barX = WIDTH - barWidth - 8.f;
-        float barY = 8.f + heartSize + 12.f;
-        
-        // Guardar la posición de la barra para interacción con mouse
-        volumeBarRect = sf::FloatRect(barX, barY, barWidth, barHeight);
-        
-        // Fondo de la barra (gris oscuro)
-        sf::RectangleShape barBg(sf::Vector2f(barWidth, barHeight));
-        barBg.setPosition(barX, barY);
-        barBg.setFillColor(sf::Color(64, 64, 64));
-        window.draw(barBg);
-        
-        // Barra de volumen (verde/amarillo según volumen)
-        float fillWidth = (musicVolume / 100.f) * barWidth;
-        sf::RectangleShape barFill(sf::Vector2f(fillWidth, barHeight));
-        barFill.setPosition(barX, barY);
-        
-        // Color según volumen
-        if (musicVolume < 30.f) {
-            barFill.setFillColor(sf::Color::Red);
-        } else if (musicVolume < 70.f) {
-            barFill.setFillColor(sf::Color::Yellow);
-        } else {
-            barFill.setFillColor(sf::Color::Green);
-        }
-        window.draw(barFill);
-        
-        // Borde de la barra
-        sf::RectangleShape barBorder(sf::Vector2f(barWidth, barHeight));
-        barBorder.setPosition(barX, barY);
-        barBorder.setFillColor(sf::Color::Transparent);
-        barBorder.setOutlineThickness(1.f);
-        barBorder.setOutlineColor(sf::Color::White);
-        window.draw(barBorder);
-        
-        // Texto de volumen
-        sf::Text volText(std::to_string((int)musicVolume) + "%", font, 12);
-        volText.setFillColor(sf::Color::White);
-        volText.setPosition(barX, barY + barHeight + 2.f);
-        window.draw(volText);
-        
-        // Botones de control de música (debajo de la barra de volumen)
-        float btnSize = 28.f;
-        float gap = 8.f;
-        float btnY = barY + barHeight + 18.f;
-        // Centrar los 3 botones respecto a la barra
-        float centerX = barX + barWidth/2.f;
-        float totalW = btnSize*3 + gap*2;
-        float startX = centerX - totalW/2.f;
-
-        // Rects de los botones
-        prevButtonRect = sf::FloatRect(startX, btnY, btnSize, btnSize);
-        playPauseButtonRect = sf::FloatRect(startX + (btnSize + gap), btnY, btnSize, btnSize);
-        nextButtonRect = sf::FloatRect(startX + 2*(btnSize + gap), btnY, btnSize, btnSize);
-
-        // Dibujar fondo de los botones
-        sf::RectangleShape btnShape(sf::Vector2f(btnSize, btnSize));
-        // Prev
-        btnShape.setPosition(prevButtonRect.left, prevButtonRect.top);
-        btnShape.setFillColor(sf::Color(40,40,40));
-        btnShape.setOutlineThickness(1.f);
-        btnShape.setOutlineColor(sf::Color::White);
-        window.draw(btnShape);
-        // Play/Pause
-        btnShape.setPosition(playPauseButtonRect.left, playPauseButtonRect.top);
-        window.draw(btnShape);
-        // Next
-        btnShape.setPosition(nextButtonRect.left, nextButtonRect.top);
-        window.draw(btnShape);
-
-        // Dibujar iconos gráficos para los botones
-        // Prev: dos triángulos apuntando a la izquierda
-        auto drawLeftTriangle = [&](float x, float y, float w, float h, const sf::Color& col){
-            sf::ConvexShape tri; tri.setPointCount(3);
-            tri.setPoint(0, sf::Vector2f(x + w, y));
-            tri.setPoint(1, sf::Vector2f(x, y + h*0.5f));
-            tri.setPoint(2, sf::Vector2f(x + w, y + h));
-            tri.setFillColor(col);
-            window.draw(tri);
-        };
-        // Right-pointing triangle
-        auto drawRightTriangle = [&](float x, float y, float w, float h, const sf::Color& col){
-            sf::ConvexShape tri; tri.setPointCount(3);
-            tri.setPoint(0, sf::Vector2f(x, y));
-            tri.setPoint(1, sf::Vector2f(x + w, y + h*0.5f));
-            tri.setPoint(2, sf::Vector2f(x, y + h));
-            tri.setFillColor(col);
-            window.draw(tri);
-        };
-
-        // Prev: two left triangles
-        float triW = btnSize * 0.45f;
-        float triH = btnSize * 0.7f;
-        float padY = (btnSize - triH) * 0.5f;
-        drawLeftTriangle(prevButtonRect.left + btnSize*0.15f, prevButtonRect.top + padY, triW, triH, sf::Color::White);
-        drawLeftTriangle(prevButtonRect.left + btnSize*0.45f, prevButtonRect.top + padY, triW, triH, sf::Color::White);
-
-        // Play / Pause
-        if (currentTrackIndex >= 0 && currentTrackIndex < (int)musicTracks.size() && musicTracks[currentTrackIndex]->getStatus() == sf::Music::Playing) {
-            // Pause icon: two small rectangles
-            sf::RectangleShape r1(sf::Vector2f(btnSize*0.18f, btnSize*0.6f));
-            sf::RectangleShape r2(sf::Vector2f(btnSize*0.18f, btnSize*0.6f));
-            float rx = playPauseButtonRect.left + (btnSize - r1.getSize().x*2 - gap*0.2f)/2.f;
-            float ry = playPauseButtonRect.top + (btnSize - r1.getSize().y)/2.f;
-            r1.setPosition(rx, ry);
-            r2.setPosition(rx + r1.getSize().x + gap*0.1f, ry);
-            r1.setFillColor(sf::Color::White); r2.setFillColor(sf::Color::White);
-            window.draw(r1); window.draw(r2);
-        } else {
-            // Play icon: single right-pointing triangle
-            float pw = btnSize * 0.5f;
-            float ph = btnSize * 0.6f;
-            float px = playPauseButtonRect.left + (btnSize - pw)/2.f;
-            float py = playPauseButtonRect.top + (btnSize - ph)/2.f;
-            drawRightTriangle(px, py, pw, ph, sf::Color::White);
-        }
-
-        // Next: two right triangles
-        drawRightTriangle(nextButtonRect.left + btnSize*0.4f, nextButtonRect.top + padY, triW, triH, sf::Color::White);
-        drawRightTriangle(nextButtonRect.left + btnSize*0.1f, nextButtonRect.top + padY, triW, triH, sf::Color::White);
+    // Jugando o GameOver: fondo fijo ya escalado y estrellas
+    {
+        ProfileScope zone(zones, ProfileZone::Background);
+        drawCalls += backdrop.draw(scene);
     }
 
-    if (lives<=0) {
-        if (font.getInfo().family != "") {
-            sf::Text go("FIN DEL JUEGO", font, 48);
-            go.setFillColor(sf::Color::Red);
-            auto b = go.getLocalBounds();
-            go.setOrigin(b.width/2.f, b.height/2.f);
-            go.setPosition(WIDTH/2.f, HEIGHT/2.f - 80.f);
-            window.draw(go);
-            
-            // Mostrar puntuacion final
-            std::ostringstream finalScore;
-            finalScore << "Puntuacion Final: " << score;
-            sf::Text finalScoreText(finalScore.str(), font, 32);
-            finalScoreText.setFillColor(sf::Color::Yellow);
-            auto fb = finalScoreText.getLocalBounds();
-            finalScoreText.setOrigin(fb.width/2.f, fb.height/2.f);
-            finalScoreText.setPosition(WIDTH/2.f, HEIGHT/2.f);
-            window.draw(finalScoreText);
-            
-            // Mostrar puntuacion maxima
-            std::ostringstream maxScoreStr;
-            maxScoreStr << "Mejor Puntuacion: " << maxScore;
-            sf::Text maxScoreText(maxScoreStr.str(), font, 32);
-            maxScoreText.setFillColor(sf::Color::Cyan);
-            auto mb = maxScoreText.getLocalBounds();
-            maxScoreText.setOrigin(mb.width/2.f, mb.height/2.f);
-            maxScoreText.setPosition(WIDTH/2.f, HEIGHT/2.f + 60.f);
-            window.draw(maxScoreText);
-            
-            // Instrucciones
-            sf::Text instructions("Pulsa R para reiniciar o M para menu", font, 24);
-            instructions.setFillColor(sf::Color::White);
-            auto ib = instructions.getLocalBounds();
-            instructions.setOrigin(ib.width/2.f, ib.height/2.f);
-            instructions.setPosition(WIDTH/2.f, HEIGHT/2.f + 140.f);
-            window.draw(instructions);
-        }
+    // balas, asteroides y jugador en lotes: una llamada por cambio de textura
+    {
+        ProfileScope zone(zones, ProfileZone::Entities);
+        batch.begin();
+        for (const Bullet& b : snap.bullets) b.draw(batch, alpha);
+        for (const Asteroid& a : snap.asteroids) a.draw(batch, alpha);
+        for (const Ship& g : snap.guests) if (g.alive) g.draw(batch, alpha);
+        if (snap.player.alive) snap.player.draw(batch, alpha);
+        drawCalls += batch.flush(scene);
+        // todas las partículas en una llamada, interpoladas hacia atrás lo que falta del tick
+        drawCalls += f.particles.draw(scene, particleVertices, (1.f - alpha) / tickRate);
     }
 
-    window.display();
-}
-
-void Game::spawnAsteroids(unsigned n) {
-    for (unsigned i=0;i<n;i++) {
-        Asteroid a;
-        // colocar alrededor de los bordes de la pantalla
-        int side = std::rand()%4;
-        switch(side) {
-            case 0: a.position = {float(std::rand()%WIDTH), -20.f}; break;
-            case 1: a.position = {float(std::rand()%WIDTH), float(HEIGHT+20)}; break;
-            case 2: a.position = {-20.f, float(std::rand()%HEIGHT)}; break;
-            default: a.position = {float(WIDTH+20), float(std::rand()%HEIGHT)}; break;
-        }
-        float ang = (std::rand()%360) * 3.14159f/180.f;
-        // Dificultad: aumentar la velocidad de los asteroides lentamente con el tiempo
-        float difficultyMultiplier = 1.0f + (elapsedTime / 60.0f); // +100% de velocidad por minuto
-        float speed = (30.f + std::rand()%80) * difficultyMultiplier;
-        a.velocity = {std::cos(ang)*speed, std::sin(ang)*speed};
-        a.size = 2;
-        a.radius = 32.f + std::rand()%16;
-        a.alive = true;
-        // asignar textura si está disponible
-        auto it = textures.find("asteroid");
-        if (it != textures.end()) a.texture = &it->second;
-        asteroids.push_back(a);
+    if (scaled) {
+        sceneTarget.display();
+        const sf::Vector2u size = sceneTarget.getSize();
+        sf::IntRect used(0, 0, std::max(1, (int)(size.x * renderScale)), std::max(1, (int)(size.y * renderScale)));
+        sf::Sprite sprite(sceneTarget.getTexture(), used);
+        sprite.setScale(WORLD_WIDTH / (float)used.width, WORLD_HEIGHT / (float)used.height);
+        window.draw(sprite);
+        drawCalls++;
     }
-}
 
-void Game::resetLevel() {
-    asteroids.clear(); bullets.clear();
-    player.reset(sf::Vector2f(WIDTH/2.f, HEIGHT/2.f));
-    player.alive = true;
-    spawnAsteroids(6);
-}
-
-bool Game::circleCollision(const sf::Vector2f& aPos, float aR, const sf::Vector2f& bPos, float bR) {
-    float dx = aPos.x - bPos.x;
-    float dy = aPos.y - bPos.y;
-    float r = aR + bR;
-    return (dx*dx + dy*dy) <= (r*r);
-}
+    ProfileScope hudZone(zones, ProfileZone::Hud);
+
+    // HUD: los valores se pasan cada frame, pero solo se regenera lo que cambió
+    hud.setScore(snap.score);
+    hud.setLives(snap.lives);
+    hud.setVolume(f.musicVolume);
+    hud.setMusicPlaying(f.musicPlaying);
+    // F3: información de depuración del frame anterior
+    if (f.showDebug) {
+        hud.setDebugStats(lastDrawCalls, batch.vertexCount(), snap.asteroids.size(), snap.bullets.size(),
+                          scaled ? renderScale : 1.f);
+        hud.setProfileText(f.profileText);
+    }
+    drawCalls += hud.draw(window, f.showDebug);
 
-void Game::loadMusicTracks() {
-    // Cargar las 7 canciones
-    musicPaths = {
-        "assets/Musica/song1.mp3",
-        "assets/Musica/song2.mp3",
-        "assets/Musica/song3.mp3",
-        "assets/Musica/song4.mp3",
-        "assets/Musica/song5.mp3",
-        "assets/Musica/song6.mp3",
-        "assets/Musica/song7.mp3"
-    };
-    
-    // Intentar cargar cada canción
-    for (const auto& path : musicPaths) {
-        auto music = std::make_unique<sf::Music>();
-        if (music->openFromFile(path)) {
-            musicTracks.push_back(std::move(music));
-        }
+    if (snap.gameOver) {
+        gameOverUi.setScores(snap.score, snap.maxScore);
+        drawCalls += gameOverUi.draw(window);
     }
-}
 
-void Game::playRandomTrack() {
-    if (musicTracks.empty()) return;
-    
-    // Seleccionar una canción aleatoria
-    currentTrackIndex = std::rand() % musicTracks.size();
-    musicTracks[currentTrackIndex]->setVolume(musicVolume);
-    musicTracks[currentTrackIndex]->play();
+    if (scaled) adaptRenderScale(std::chrono::duration<float>(std::chrono::steady_clock::now() - renderStart).count());
+    window.display();
 }
 
-void Game::updateMusic() {
-    if (musicTracks.empty()) return;
-    
-    // Verificar si la canción actual está reproduciéndose
-    if (currentTrackIndex >= 0 && currentTrackIndex < (int)musicTracks.size()) {
-        // Solo avanzar a otra pista si la actual terminó (Stopped).
-        if (musicTracks[currentTrackIndex]->getStatus() == sf::Music::Stopped) {
-            playRandomTrack();
-        }
+bool Game::prepareSceneTarget(sf::Vector2u pixels) {
+    if (pixels.x == 0 || pixels.y == 0) return false;
+    // se crea al tamaño completo y solo al cambiar la ventana; la escala usa una parte
+    if (sceneTarget.getSize() != pixels) {
+        if (!sceneTarget.create(pixels.x, pixels.y)) return false;
+        sceneTarget.setSmooth(true);
     }
+    return true;
 }
 
-// Reproducir / pausar la pista actual
-void Game::toggleMusicPlayPause() {
-    if (musicTracks.empty() || currentTrackIndex < 0) return;
-    auto& m = musicTracks[currentTrackIndex];
-    if (m->getStatus() == sf::Music::Playing) m->pause();
-    else m->play();
-}
-
-// Reproducir siguiente pista
-void Game::playNextTrack() {
-    if (musicTracks.empty()) return;
-    int n = (int)musicTracks.size();
-    int next = (currentTrackIndex + 1) % n;
-    if (currentTrackIndex >= 0) musicTracks[currentTrackIndex]->stop();
-    currentTrackIndex = next;
-    musicTracks[currentTrackIndex]->setVolume(musicVolume);
-    musicTracks[currentTrackIndex]->play();
-}
-
-// Reproducir pista anterior
-void Game::playPrevTrack() {
-    if (musicTracks.empty()) return;
-    int n = (int)musicTracks.size();
-    int prev = (currentTrackIndex - 1 + n) % n;
-    if (currentTrackIndex >= 0) musicTracks[currentTrackIndex]->stop();
-    currentTrackIndex = prev;
-    musicTracks[currentTrackIndex]->setVolume(musicVolume);
-    musicTracks[currentTrackIndex]->play();
+void Game::adaptRenderScale(float seconds) {
+    // Tiempo de dibujo sin la espera de display() (límite de FPS o vsync): cuando
+    // la GPU no da abasto, las llamadas de dibujo se bloquean y lo suben.
+    renderSeconds += (seconds - renderSeconds) * 0.1f;
+    // cambios pequeños y espaciados para que la nitidez no oscile de un frame a otro
+    if (++scaleFrames < 15) return;
+    scaleFrames = 0;
+    if (renderSeconds > renderBudget * 0.9f) renderScale = std::max(0.5f, renderScale - 0.05f);
+    else if (renderSeconds < renderBudget * 0.6f) renderScale = std::min(1.f, renderScale + 0.05f);
 }
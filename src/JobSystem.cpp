@@ -0,0 +1,89 @@
+#include "JobSystem.hpp"
+
+void JobSystem::WorkQueue::push(const Task& t) {
+    std::lock_guard<std::mutex> lock(mutex);
+    tasks.push_back(t);
+}
+
+bool JobSystem::WorkQueue::pop(Task& t) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (head == tasks.size()) return false;
+    t = tasks.back();
+    tasks.pop_back();
+    if (head == tasks.size()) { tasks.clear(); head = 0; }
+    return true;
+}
+
+bool JobSystem::WorkQueue::steal(Task& t) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (head == tasks.size()) return false;
+    t = tasks[head++];
+    if (head == tasks.size()) { tasks.clear(); head = 0; }
+    return true;
+}
+
+JobSystem::JobSystem(unsigned workers) {
+    if (workers == 0) {
+        unsigned hw = std::thread::hardware_concurrency();
+        workers = hw > 1 ? hw - 1 : 0;
+    }
+    for (unsigned i = 0; i <= workers; ++i) {
+        queues.push_back(std::make_unique<WorkQueue>());
+        queues.back()->tasks.reserve(64);
+    }
+    for (unsigned i = 1; i <= workers; ++i) threads.emplace_back(&JobSystem::workerLoop, this, i);
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& t : threads) t.join();
+}
+
+void JobSystem::run(size_t count, size_t grain, RangeFn fn, void* ctx) {
+    // repartir los trozos en orden entre todas las colas (round-robin)
+    size_t chunks = (count + grain - 1) / grain;
+    pending.store(chunks, std::memory_order_relaxed);
+    for (size_t c = 0; c < chunks; ++c) {
+        size_t begin = c * grain;
+        size_t end = begin + grain < count ? begin + grain : count;
+        queues[c % queues.size()]->push(Task{fn, ctx, begin, end});
+    }
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        generation++;
+    }
+    wake.notify_all();
+
+    // el hilo que llama también trabaja hasta que no quede nada pendiente
+    while (pending.load(std::memory_order_acquire) > 0) {
+        if (!runOne(0)) std::this_thread::yield();
+    }
+}
+
+bool JobSystem::runOne(unsigned slot) {
+    Task t;
+    bool found = queues[slot]->pop(t);
+    for (size_t i = 1; !found && i < queues.size(); ++i)
+        found = queues[(slot + i) % queues.size()]->steal(t);
+    if (!found) return false;
+    t.fn(t.ctx, t.begin, t.end, slot);
+    pending.fetch_sub(1, std::memory_order_acq_rel);
+    return true;
+}
+
+void JobSystem::workerLoop(unsigned slot) {
+    unsigned seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+        }
+        while (runOne(slot)) {}
+    }
+}
@@ -0,0 +1,166 @@
+#include "MusicPlayer.hpp"
+#include <algorithm>
+#include <chrono>
+
+// Duración del fundido al acabar una pista y al cambiarla a mano.
+static const float CROSSFADE_SECONDS = 3.f;
+static const float SKIP_FADE_SECONDS = 0.5f;
+// La siguiente pista se abre cuando a la actual le queda esto.
+static const float PREFETCH_SECONDS = 10.f;
+
+void MusicPlayer::setTracks(std::vector<std::string> list) {
+    paths = std::move(list);
+    broken.assign(paths.size(), false);
+}
+
+void MusicPlayer::start() {
+    if (paths.empty()) return;
+    skipTo((int)rng.below((std::uint32_t)paths.size()));
+}
+
+void MusicPlayer::update(float dt) {
+    if (paths.empty()) return;
+    pump();
+
+    if (incoming) {
+        if (!paused) fade += dt;
+        if (fade >= fadeLength) finishCrossfade();
+        applyVolumes();
+        return;
+    }
+    if (paused) return;
+
+    bool ended = !current || current->getStatus() == sf::Music::Stopped;
+    float duration = current ? current->getDuration().asSeconds() : 0.f;
+    float left = duration > 0.f ? duration - current->getPlayingOffset().asSeconds() : 0.f;
+    bool nearEnd = duration > 0.f && left < PREFETCH_SECONDS;
+
+    if (wantedIndex < 0 && (ended || nearEnd)) {
+        wantedIndex = randomNext();
+        pump();
+    }
+    if (prefetched && (skipRequested || ended || (duration > 0.f && left <= CROSSFADE_SECONDS)))
+        beginCrossfade(skipRequested ? SKIP_FADE_SECONDS : CROSSFADE_SECONDS);
+}
+
+void MusicPlayer::pump() {
+    if (opening.valid() && opening.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        Stream music = opening.get();
+        int index = openingIndex;
+        openingIndex = -1;
+        if (!music) {
+            broken[index] = true;
+            if (index == wantedIndex) wantedIndex = randomNext();
+        } else if (index == wantedIndex) {
+            prefetched = std::move(music);
+            prefetchedIndex = index;
+        }
+        // si ya se pidió otra pista, esta se cierra aquí sin llegar a sonar
+    }
+    if (wantedIndex >= 0 && wantedIndex != prefetchedIndex && !opening.valid()) {
+        prefetched.reset();
+        prefetchedIndex = -1;
+        openingIndex = wantedIndex;
+        std::string path = paths[wantedIndex];
+        const PackEntry* entry = pack ? pack->find(path) : nullptr;
+        opening = std::async(std::launch::async, [path, entry] {
+            Stream music(new sf::Music());
+            bool ok = entry ? music->openFromMemory(entry->data, entry->size) : music->openFromFile(path);
+            if (!ok) music.reset();
+            return music;
+        });
+    }
+}
+
+int MusicPlayer::randomNext() {
+    std::uint32_t count = 0;
+    for (int i = 0; i < (int)paths.size(); ++i)
+        if (!broken[i] && i != currentIndex) count++;
+    if (count == 0) return currentIndex >= 0 && !broken[currentIndex] ? currentIndex : -1;
+    std::uint32_t pick = rng.below(count);
+    for (int i = 0; i < (int)paths.size(); ++i)
+        if (!broken[i] && i != currentIndex && pick-- == 0) return i;
+    return -1;
+}
+
+int MusicPlayer::neighbour(int step) {
+    int n = (int)paths.size();
+    int i = currentIndex < 0 ? 0 : currentIndex;
+    for (int tries = 0; tries < n; ++tries) {
+        i = (i + step + n) % n;
+        if (!broken[i]) return i;
+    }
+    return -1;
+}
+
+void MusicPlayer::skipTo(int index) {
+    if (index < 0) return;
+    if (incoming) finishCrossfade();
+    wantedIndex = index;
+    skipRequested = true;
+    pump();
+}
+
+void MusicPlayer::beginCrossfade(float seconds) {
+    Stream music = std::move(prefetched);
+    int index = prefetchedIndex;
+    prefetchedIndex = -1;
+    wantedIndex = -1;
+    skipRequested = false;
+    if (!current || current->getStatus() == sf::Music::Stopped) {
+        // nada que fundir: entra directamente
+        current = std::move(music);
+        currentIndex = index;
+        current->setVolume(volume);
+        if (!paused) current->play();
+        return;
+    }
+    incoming = std::move(music);
+    incomingIndex = index;
+    fade = 0.f;
+    fadeLength = seconds;
+    applyVolumes();
+    incoming->play();
+}
+
+void MusicPlayer::finishCrossfade() {
+    current->stop();
+    current = std::move(incoming);
+    currentIndex = incomingIndex;
+    incomingIndex = -1;
+    fade = 0.f;
+    applyVolumes();
+}
+
+void MusicPlayer::applyVolumes() {
+    float t = incoming ? std::min(1.f, fade / fadeLength) : 0.f;
+    if (current) current->setVolume(volume * (1.f - t));
+    if (incoming) incoming->setVolume(volume * t);
+}
+
+void MusicPlayer::next() {
+    skipTo(neighbour(1));
+}
+
+void MusicPlayer::prev() {
+    skipTo(neighbour(-1));
+}
+
+void MusicPlayer::togglePause() {
+    if (!current) return;
+    paused = !paused;
+    for (sf::Music* m : {current.get(), incoming.get()}) {
+        if (!m) continue;
+        if (paused) m->pause();
+        else m->play();
+    }
+}
+
+void MusicPlayer::setVolume(float v) {
+    volume = v;
+    applyVolumes();
+}
+
+bool MusicPlayer::isPlaying() const {
+    return current && current->getStatus() == sf::Music::Playing;
+}
@@ -0,0 +1,317 @@
+#include "NetClient.hpp"
+#include "World.hpp"
+#include "WorldSize.hpp"
+#include "Replay.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+// Sin instantáneas en este tiempo se da el servidor por perdido.
+static const float SERVER_TIMEOUT_SECONDS = 5.f;
+// Retraso mínimo de lo interpolado (segundos) y en instantáneas: con 2.5
+// intervalos de margen se puede perder una sin quedarse sin la siguiente.
+static const float MIN_INTERPOLATION_DELAY = 0.1f;
+static const float INTERPOLATION_SNAPSHOTS = 2.5f;
+// Lo más que se extrapola si dejan de llegar instantáneas (segundos).
+static const float MAX_EXTRAPOLATION = 0.25f;
+// Ticks entre saludos mientras no llega la primera instantánea.
+static const unsigned HELLO_INTERVAL = 15;
+
+bool NetClient::connect(const std::string& host, unsigned short port, float rate) {
+    disconnect();
+    server = sf::IpAddress(host);
+    if (server == sf::IpAddress::None) {
+        std::fprintf(stderr, "no se pudo resolver %s\n", host.c_str());
+        return false;
+    }
+    if (socket.bind(sf::Socket::AnyPort) != sf::Socket::Done) {
+        std::fprintf(stderr, "no se pudo abrir un puerto UDP local\n");
+        return false;
+    }
+    socket.setBlocking(false);
+    serverPort = port;
+    tickRate = rate;
+    snapshots.assign(HISTORY, NetState());
+    inputs.assign(INPUT_HISTORY, 0);
+    buffer.resize(sf::UdpSocket::MaxDatagramSize);
+    latest = snapshotGap = 0;
+    ackedInput = inputSeq = 0;
+    ticksSinceLatest = 0.f;
+    hasShown = false;
+    helloCountdown = 0;
+    netStats = NetStats();
+    heardAt = std::chrono::steady_clock::now();
+    open = true;
+    return true;
+}
+
+void NetClient::disconnect() {
+    if (!open) return;
+    packet.bytes.clear();
+    packet.u8((std::uint32_t)NetPacket::Bye);
+    socket.send(packet.bytes.data(), packet.bytes.size(), server, serverPort);
+    socket.unbind();
+    open = false;
+    latest = 0;
+}
+
+bool NetClient::timedOut() const {
+    return open && std::chrono::duration<float>(std::chrono::steady_clock::now() - heardAt).count() > SERVER_TIMEOUT_SECONDS;
+}
+
+void NetClient::sendPacket() {
+    packet.bytes.clear();
+    if (!connected()) {
+        if (helloCountdown-- > 0) return;
+        helloCountdown = HELLO_INTERVAL;
+        packet.u8((std::uint32_t)NetPacket::Hello);
+        packet.u32(NET_PROTOCOL);
+    } else {
+        // las últimas entradas que el servidor no confirmó, por si se perdió un paquete
+        std::uint32_t first = inputSeq > NET_INPUT_REDUNDANCY ? inputSeq - NET_INPUT_REDUNDANCY : 0;
+        first = std::max(first, std::min(ackedInput, inputSeq));
+        packet.u8((std::uint32_t)NetPacket::Input);
+        packet.u32(latest);
+        packet.u32(netMillis());
+        packet.u16((std::uint32_t)std::min(65535.f, std::round(netStats.rttMs)));
+        packet.u32(first);
+        packet.u8(inputSeq - first);
+        for (std::uint32_t seq = first; seq < inputSeq; ++seq) packet.u8(inputs[seq % INPUT_HISTORY]);
+    }
+    if (socket.send(packet.bytes.data(), packet.bytes.size(), server, serverPort) == sf::Socket::Done)
+        netStats.sent(packet.bytes.size());
+}
+
+void NetClient::handleSnapshot(const std::uint8_t* data, size_t size) {
+    NetReader in(data, size);
+    in.u8();
+    const std::uint32_t tick = in.u32();
+    const std::uint32_t baseTick = in.u32();
+    const std::uint32_t hz = in.u16();
+    const std::uint8_t id = (std::uint8_t)in.u8();
+    const std::uint32_t ackInput = in.u32();
+    const std::uint32_t echoMs = in.u32();
+    const std::uint32_t heldMs = in.u16();
+    // las atrasadas o repetidas no sirven: ya hay una más nueva
+    if (!in.ok || tick == 0 || tick <= latest || hz == 0) return;
+
+    const NetState* baseline = nullptr;
+    if (baseTick != 0) {
+        baseline = &snapshots[baseTick % HISTORY];
+        if (baseline->tick != baseTick || tick - baseTick >= HISTORY) return;
+    }
+    scratch.tick = tick;
+    if (!decodeSnapshot(in, scratch, baseline, hz)) return;
+    std::swap(snapshots[tick % HISTORY], scratch);
+
+    snapshotGap = latest ? tick - latest : 0;
+    latest = tick;
+    ticksSinceLatest = 0.f;
+    serverHz = hz;
+    myId = id;
+    ackedInput = std::max(ackedInput, std::min(ackInput, inputSeq));
+    netStats.lastSnapshotBytes = (std::uint32_t)size;
+    heardAt = std::chrono::steady_clock::now();
+    // ida y vuelta sin lo que el paquete esperó en el servidor
+    const std::uint32_t rtt = netMillis() - echoMs;
+    if (echoMs != 0 && rtt >= heldMs && rtt - heldMs < 10000) netStats.addRttSample((float)(rtt - heldMs));
+}
+
+void NetClient::receive() {
+    std::size_t size = 0;
+    sf::IpAddress address;
+    unsigned short port = 0;
+    while (socket.receive(buffer.data(), buffer.size(), size, address, port) == sf::Socket::Done) {
+        if (address != server || port != serverPort || size == 0) continue;
+        netStats.received(size);
+        if ((NetPacket)buffer[0] == NetPacket::Snapshot) handleSnapshot(buffer.data(), size);
+    }
+}
+
+// Interpolación cuantizada; si entre las dos dio la vuelta por el borde, salta a la mitad.
+static std::uint16_t lerpPosition(std::uint16_t a, std::uint16_t b, float t, float limit) {
+    const float half = limit * 0.5f * 16.f;
+    if (std::abs((float)b - (float)a) > half) return t < 0.5f ? a : b;
+    return (std::uint16_t)std::lround(a + (b - a) * t);
+}
+
+// Posición de `e` `ticks` ticks después en línea recta (sin envolver: solo se
+// extrapola un momento).
+static std::uint16_t extrapolate(std::uint16_t p, std::int16_t v, float ticks, std::uint32_t hz) {
+    float q = p + v * 4.f * ticks / hz;
+    return (std::uint16_t)std::lround(std::min(65535.f, std::max(0.f, q)));
+}
+
+bool NetClient::sample(float at, NetState& out) const {
+    // las dos recibidas que rodean `at` (o la más vieja, si aún no hay una anterior)
+    const NetState* a = nullptr;
+    const NetState* b = nullptr;
+    for (const NetState& s : snapshots) {
+        if (s.tick == 0) continue;
+        if (s.tick <= at) { if (!a || s.tick > a->tick) a = &s; }
+        else if (!b || s.tick < b->tick) b = &s;
+    }
+    if (!a) { a = b; b = nullptr; at = a ? (float)a->tick : at; }
+    if (!a) return false;
+    const float since = std::min(at - a->tick, MAX_EXTRAPOLATION * serverHz);
+    const float t = b ? (at - a->tick) / (float)(b->tick - a->tick) : 0.f;
+
+    out.tick = (std::uint32_t)at;
+    out.score = a->score;
+    out.lives = a->lives;
+    out.ships.clear();
+    for (const NetShip& s : a->ships) {
+        NetShip r = s;
+        const NetShip* next = nullptr;
+        if (b) for (const NetShip& n : b->ships) if (n.id == s.id) next = &n;
+        if (next && next->deaths == s.deaths) {
+            r.x = lerpPosition(s.x, next->x, t, WORLD_WIDTH);
+            r.y = lerpPosition(s.y, next->y, t, WORLD_HEIGHT);
+            r.angle = (std::uint16_t)(s.angle + (int)std::lround((std::int16_t)(next->angle - s.angle) * t));
+        } else if (!next) {
+            r.x = extrapolate(s.x, s.vx, since, serverHz);
+            r.y = extrapolate(s.y, s.vy, since, serverHz);
+        }
+        out.ships.push_back(r);
+    }
+
+    auto entities = [&](const std::vector<NetEntity>& from, const std::vector<NetEntity>* to, std::vector<NetEntity>& result) {
+        result.clear();
+        size_t j = 0;
+        for (const NetEntity& e : from) {
+            NetEntity r = e;
+            if (to) while (j < to->size() && (*to)[j].slot < e.slot) ++j;
+            if (to && j < to->size() && (*to)[j].slot == e.slot && (*to)[j].generation == e.generation) {
+                r.x = lerpPosition(e.x, (*to)[j].x, t, WORLD_WIDTH);
+                r.y = lerpPosition(e.y, (*to)[j].y, t, WORLD_HEIGHT);
+            } else {
+                // destruida antes de `b` (o no hay `b`): sigue su trayecto hasta entonces
+                r.x = extrapolate(e.x, e.vx, since, serverHz);
+                r.y = extrapolate(e.y, e.vy, since, serverHz);
+            }
+            result.push_back(r);
+        }
+    };
+    entities(a->asteroids, b ? &b->asteroids : nullptr, out.asteroids);
+    entities(a->bullets, b ? &b->bullets : nullptr, out.bullets);
+    return true;
+}
+
+template <class T>
+static const T* findEntity(const std::vector<T>& list, const T& e) {
+    auto it = std::lower_bound(list.begin(), list.end(), e, [](const T& l, const T& r) { return l.slot < r.slot; });
+    return it != list.end() && it->slot == e.slot && it->generation == e.generation ? &*it : nullptr;
+}
+
+static sf::Vector2f positionOf(std::uint16_t x, std::uint16_t y) {
+    return sf::Vector2f(dequantizePosition(x), dequantizePosition(y));
+}
+
+static sf::Vector2f velocityOf(std::int16_t vx, std::int16_t vy) {
+    return sf::Vector2f(dequantizeVelocity(vx), dequantizeVelocity(vy));
+}
+
+void NetClient::present(World& world, const NetState& now, float dt) {
+    world.shotsFired = 0;
+    world.asteroidsDestroyed = 0;
+    world.explosions.clear();
+    // eventos: lo que desapareció o apareció desde la muestra anterior (una
+    // partida nueva se lleva todos los asteroides sin explosiones)
+    if (hasShown && now.score >= shown.score) {
+        for (const NetEntity& e : shown.asteroids) {
+            if (findEntity(now.asteroids, e)) continue;
+            world.explosions.push_back({positionOf(e.x, e.y), velocityOf(e.vx, e.vy), e.radius / 4.f, false});
+            world.asteroidsDestroyed++;
+        }
+        for (const NetEntity& e : now.bullets)
+            if (!findEntity(shown.bullets, e)) world.shotsFired++;
+        for (const NetShip& s : shown.ships)
+            for (const NetShip& n : now.ships)
+                if (n.id == s.id && n.deaths != s.deaths && n.id != myId)
+                    world.explosions.push_back({positionOf(s.x, s.y), velocityOf(s.vx, s.vy), world.player.radius, true});
+    }
+
+    // el World del cliente es solo un contenedor para dibujar: se rehace cada tick
+    world.asteroids.clear();
+    for (const NetEntity& e : now.asteroids) {
+        Asteroid a;
+        a.position = positionOf(e.x, e.y);
+        a.velocity = velocityOf(e.vx, e.vy);
+        a.prevPosition = a.position - a.velocity * dt;
+        a.radius = e.radius / 4.f;
+        a.size = e.size;
+        world.asteroids.spawn(a);
+    }
+    world.bullets.clear();
+    for (const NetEntity& e : now.bullets) {
+        Bullet b;
+        b.position = positionOf(e.x, e.y);
+        b.velocity = velocityOf(e.vx, e.vy);
+        b.prevPosition = b.position - b.velocity * dt;
+        world.bullets.spawn(b);
+    }
+    world.score = now.score;
+    world.maxScore = std::max(world.maxScore, now.score);
+    world.lives = now.lives;
+
+    world.guests.clear();
+    for (const NetShip& s : now.ships) {
+        if (s.id == myId) continue;
+        World::Guest g;
+        g.id = s.id;
+        g.ship.sprite = world.player.sprite;
+        applyShip(s, g.ship);
+        g.ship.prevPosition = g.ship.position - g.ship.velocity * dt;
+        world.guests.push_back(g);
+    }
+
+    // nave propia: la última autoritativa más las entradas que el servidor no aplicó todavía
+    const NetState& last = snapshots[latest % HISTORY];
+    for (const NetShip& s : last.ships) {
+        if (s.id != myId) continue;
+        Ship& ship = world.player;
+        const sf::Vector2f before = ship.position;
+        const float beforeAngle = ship.angle;
+        const std::uint8_t deaths = ship.deaths;
+        applyShip(s, ship);
+        if (ship.alive) {
+            for (std::uint32_t seq = ackedInput; seq < inputSeq; ++seq) {
+                ship.handleInput(Replay::unpackInput(inputs[seq % INPUT_HISTORY]), dt);
+                ship.update(dt);
+            }
+        }
+        if (hasShown && deaths != ship.deaths) {
+            world.explosions.push_back({before, ship.velocity, ship.radius, true});
+        } else if (hasShown) {
+            // continuidad con lo dibujado el tick anterior (el ángulo, sin vueltas de 360)
+            ship.prevPosition = before;
+            ship.prevAngle = beforeAngle + 360.f * std::round((ship.angle - beforeAngle) / 360.f);
+        }
+    }
+    shown = now;
+    hasShown = true;
+}
+
+void NetClient::update(World& world, const ShipInput& input) {
+    if (!open) return;
+    if (connected()) {
+        inputs[inputSeq % INPUT_HISTORY] = Replay::packInput(input);
+        inputSeq++;
+    }
+    sendPacket();
+    receive();
+    netStats.update(std::chrono::steady_clock::now());
+    if (!connected()) return;
+
+    // tick del servidor estimado y, un poco antes, el momento que se muestra
+    ticksSinceLatest += serverHz / tickRate;
+    const float delay = std::max(MIN_INTERPOLATION_DELAY * serverHz, INTERPOLATION_SNAPSHOTS * snapshotGap);
+    const float at = std::max(1.f, latest + ticksSinceLatest - delay);
+    if (sample(at, current)) present(world, current, 1.f / serverHz);
+}
+
+std::string NetClient::describe() const {
+    char head[96];
+    std::snprintf(head, sizeof(head), "servidor %s:%u, tick %u: ", server.toString().c_str(), (unsigned)serverPort, latest);
+    return head + netStats.describe();
+}
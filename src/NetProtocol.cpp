@@ -0,0 +1,388 @@
+#include "NetProtocol.hpp"
+#include "World.hpp"
+#include "WorldSize.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+// Unidades de cuantización: 1/16 px en posición (con 64 px de margen para los
+// que están saliendo por el borde), 1/4 px/s en velocidad, 1/4 px en radio.
+static const float POS_SCALE = 16.f;
+static const float POS_OFFSET = 64.f;
+static const float VEL_SCALE = 4.f;
+static const float RADIUS_SCALE = 4.f;
+// Diferencia con la predicción que se deja pasar sin enviar (en 1/16 px): la
+// integración en float y la entera se separan algún dieciseisavo de vez en cuando.
+static const int POS_TOLERANCE = 2;
+
+// Bits de cada entrada escrita de un pool.
+enum : std::uint32_t { FIELD_NEW = 1, FIELD_X = 2, FIELD_Y = 4, FIELD_VX = 8, FIELD_VY = 16 };
+
+void NetWriter::u8(std::uint32_t v) {
+    bytes.push_back((std::uint8_t)v);
+}
+
+void NetWriter::u16(std::uint32_t v) {
+    bytes.push_back((std::uint8_t)v);
+    bytes.push_back((std::uint8_t)(v >> 8));
+}
+
+void NetWriter::u32(std::uint32_t v) {
+    for (int i = 0; i < 4; ++i) bytes.push_back((std::uint8_t)(v >> (8*i)));
+}
+
+void NetWriter::varint(std::uint32_t v) {
+    while (v >= 0x80) { bytes.push_back((std::uint8_t)(v | 0x80)); v >>= 7; }
+    bytes.push_back((std::uint8_t)v);
+}
+
+std::uint32_t NetReader::u8() {
+    if (pos + 1 > size) { ok = false; return 0; }
+    return data[pos++];
+}
+
+std::uint32_t NetReader::u16() {
+    if (pos + 2 > size) { ok = false; return 0; }
+    std::uint32_t v = data[pos] | ((std::uint32_t)data[pos+1] << 8);
+    pos += 2;
+    return v;
+}
+
+std::uint32_t NetReader::u32() {
+    if (pos + 4 > size) { ok = false; return 0; }
+    std::uint32_t v = 0;
+    for (int i = 0; i < 4; ++i) v |= (std::uint32_t)data[pos++] << (8*i);
+    return v;
+}
+
+std::uint32_t NetReader::varint() {
+    std::uint32_t v = 0;
+    for (int shift = 0; shift < 35 && pos < size; shift += 7) {
+        std::uint8_t b = data[pos++];
+        v |= (std::uint32_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) return v;
+    }
+    ok = false;
+    return 0;
+}
+
+template <class T>
+static T clampRound(float v, float lo, float hi) {
+    return (T)std::lround(std::min(hi, std::max(lo, v)));
+}
+
+std::uint16_t quantizePosition(float p) {
+    return clampRound<std::uint16_t>((p + POS_OFFSET) * POS_SCALE, 0.f, 65535.f);
+}
+
+float dequantizePosition(std::uint16_t q) {
+    return q / POS_SCALE - POS_OFFSET;
+}
+
+std::int16_t quantizeVelocity(float v) {
+    return clampRound<std::int16_t>(v * VEL_SCALE, -32767.f, 32767.f);
+}
+
+float dequantizeVelocity(std::int16_t q) {
+    return q / VEL_SCALE;
+}
+
+NetShip quantizeShip(const Ship& ship, std::uint8_t id) {
+    NetShip q;
+    q.id = id;
+    q.deaths = ship.deaths;
+    q.alive = ship.alive;
+    q.thrusting = ship.thrusting;
+    q.x = quantizePosition(ship.position.x);
+    q.y = quantizePosition(ship.position.y);
+    q.vx = quantizeVelocity(ship.velocity.x);
+    q.vy = quantizeVelocity(ship.velocity.y);
+    float a = std::fmod(ship.angle, 360.f);
+    if (a < 0.f) a += 360.f;
+    q.angle = (std::uint16_t)((std::uint32_t)std::lround(a * (65536.f / 360.f)) & 0xFFFF);
+    return q;
+}
+
+void applyShip(const NetShip& q, Ship& ship) {
+    ship.position = sf::Vector2f(dequantizePosition(q.x), dequantizePosition(q.y));
+    ship.prevPosition = ship.position;
+    ship.velocity = sf::Vector2f(dequantizeVelocity(q.vx), dequantizeVelocity(q.vy));
+    ship.angle = ship.prevAngle = q.angle * (360.f / 65536.f);
+    ship.alive = q.alive;
+    ship.thrusting = q.thrusting;
+    ship.deaths = q.deaths;
+}
+
+template <class Store>
+static NetEntity quantizeEntity(const Store& s, size_t i) {
+    NetEntity e;
+    e.slot = (std::uint16_t)i;
+    e.generation = s.generation[i];
+    e.x = quantizePosition(s.x[i]);
+    e.y = quantizePosition(s.y[i]);
+    e.vx = quantizeVelocity(s.vx[i]);
+    e.vy = quantizeVelocity(s.vy[i]);
+    return e;
+}
+
+void NetState::capture(const World& world, std::uint32_t t) {
+    tick = t;
+    score = world.score;
+    lives = (std::int8_t)std::max(-128, std::min(127, world.lives));
+    ships.clear();
+    ships.push_back(quantizeShip(world.player, 0));
+    for (const World::Guest& g : world.guests) ships.push_back(quantizeShip(g.ship, g.id));
+
+    // los slots pasan de 65535 solo con pools más grandes de lo que cabe en un datagrama
+    const AsteroidStore& as = world.asteroids;
+    asteroids.clear();
+    for (size_t i = 0; i < as.slots() && i <= 0xFFFF; ++i) {
+        if (!as.alive[i]) continue;
+        NetEntity e = quantizeEntity(as, i);
+        e.radius = clampRound<std::uint8_t>(as.radius[i] * RADIUS_SCALE, 0.f, 255.f);
+        e.size = as.size[i];
+        asteroids.push_back(e);
+    }
+    const BulletStore& bs = world.bullets;
+    bullets.clear();
+    for (size_t i = 0; i < bs.slots() && i <= 0xFFFF; ++i)
+        if (bs.alive[i]) bullets.push_back(quantizeEntity(bs, i));
+}
+
+// Un eje: desplazamiento en 1/16 px (v en 1/4 px/s durante ticks/tickHz
+// segundos) y salto al otro lado si pasa de [-margen, límite+margen].
+static std::uint16_t predictAxis(std::uint16_t p, std::int16_t v, std::uint32_t ticks, std::uint32_t tickHz,
+                                 float limit, float margin) {
+    const std::int64_t scale = (std::int64_t)(POS_SCALE / VEL_SCALE);
+    std::int64_t q = p + (std::int64_t)v * ticks * scale / std::max<std::uint32_t>(1, tickHz);
+    const std::int64_t lo = quantizePosition(-margin), hi = quantizePosition(limit + margin);
+    const std::int64_t period = std::max<std::int64_t>(1, hi - lo);
+    if (q < lo) q += ((lo - q) / period + 1) * period;
+    if (q > hi) q -= ((q - hi) / period + 1) * period;
+    return (std::uint16_t)std::min<std::int64_t>(65535, std::max<std::int64_t>(0, q));
+}
+
+void predictEntity(const NetEntity& e, std::uint32_t ticks, std::uint32_t tickHz, float margin,
+                   std::uint16_t& x, std::uint16_t& y) {
+    x = predictAxis(e.x, e.vx, ticks, tickHz, WORLD_WIDTH, margin);
+    y = predictAxis(e.y, e.vy, ticks, tickHz, WORLD_HEIGHT, margin);
+}
+
+static float marginOf(const NetEntity& e, bool bullet) {
+    return bullet ? NET_BULLET_MARGIN : e.radius / RADIUS_SCALE;
+}
+
+static NetEntity predicted(const NetEntity& e, std::uint32_t ticks, std::uint32_t tickHz, bool bullet) {
+    NetEntity p = e;
+    predictEntity(e, ticks, tickHz, marginOf(e, bullet), p.x, p.y);
+    return p;
+}
+
+static void writeShip(NetWriter& out, const NetShip& s) {
+    out.u8(s.id);
+    out.u8(s.deaths);
+    out.u8((s.alive ? 1 : 0) | (s.thrusting ? 2 : 0));
+    out.u16(s.x);
+    out.u16(s.y);
+    out.u16((std::uint16_t)s.vx);
+    out.u16((std::uint16_t)s.vy);
+    out.u16(s.angle);
+}
+
+static NetShip readShip(NetReader& in) {
+    NetShip s;
+    s.id = (std::uint8_t)in.u8();
+    s.deaths = (std::uint8_t)in.u8();
+    std::uint32_t flags = in.u8();
+    s.alive = (flags & 1) != 0;
+    s.thrusting = (flags & 2) != 0;
+    s.x = (std::uint16_t)in.u16();
+    s.y = (std::uint16_t)in.u16();
+    s.vx = (std::int16_t)in.u16();
+    s.vy = (std::int16_t)in.u16();
+    s.angle = (std::uint16_t)in.u16();
+    return s;
+}
+
+// Un pool: primero los slots que ya no están (huecos entre slots en varint),
+// después los que cambiaron: hueco, máscara de campos y esos campos; con
+// FIELD_NEW va el registro entero (alta nueva o slot reutilizado). Lo que no
+// aparece en ninguna lista es la base predicha.
+static void encodeEntities(NetWriter& out, const std::vector<NetEntity>& now, const std::vector<NetEntity>* base,
+                           std::uint32_t ticks, std::uint32_t tickHz, bool bullet, std::vector<NetEntity>& sent) {
+    static const std::vector<NetEntity> none;
+    const std::vector<NetEntity>& old = base ? *base : none;
+    sent.clear();
+
+    std::uint32_t removed = 0;
+    for (size_t i = 0, j = 0; i < old.size(); ++i) {
+        while (j < now.size() && now[j].slot < old[i].slot) ++j;
+        if (j == now.size() || now[j].slot != old[i].slot) ++removed;
+    }
+    out.varint(removed);
+    std::uint32_t last = 0;
+    for (size_t i = 0, j = 0; i < old.size(); ++i) {
+        while (j < now.size() && now[j].slot < old[i].slot) ++j;
+        if (j < now.size() && now[j].slot == old[i].slot) continue;
+        out.varint(old[i].slot - last);
+        last = old[i].slot;
+    }
+
+    // la cuenta de escritas va delante: se reserva y se rellena al final
+    NetWriter entries;
+    std::uint32_t written = 0;
+    last = 0;
+    for (size_t j = 0, i = 0; j < now.size(); ++j) {
+        const NetEntity& e = now[j];
+        while (i < old.size() && old[i].slot < e.slot) ++i;
+        std::uint32_t mask = FIELD_NEW;
+        NetEntity result = e;
+        if (i < old.size() && old[i].slot == e.slot && old[i].generation == e.generation) {
+            result = predicted(old[i], ticks, tickHz, bullet);
+            mask = 0;
+            if (std::abs((int)result.x - (int)e.x) > POS_TOLERANCE) { mask |= FIELD_X; result.x = e.x; }
+            if (std::abs((int)result.y - (int)e.y) > POS_TOLERANCE) { mask |= FIELD_Y; result.y = e.y; }
+            if (result.vx != e.vx) { mask |= FIELD_VX; result.vx = e.vx; }
+            if (result.vy != e.vy) { mask |= FIELD_VY; result.vy = e.vy; }
+        }
+        sent.push_back(result);
+        if (!mask) continue;
+        written++;
+        entries.varint(e.slot - last);
+        last = e.slot;
+        entries.u8(mask);
+        if (mask & FIELD_NEW) {
+            entries.u8(e.generation);
+            if (!bullet) { entries.u8(e.radius); entries.u8((std::uint8_t)e.size); }
+        }
+        if (mask & (FIELD_NEW | FIELD_X)) entries.u16(e.x);
+        if (mask & (FIELD_NEW | FIELD_Y)) entries.u16(e.y);
+        if (mask & (FIELD_NEW | FIELD_VX)) entries.u16((std::uint16_t)e.vx);
+        if (mask & (FIELD_NEW | FIELD_VY)) entries.u16((std::uint16_t)e.vy);
+    }
+    out.varint(written);
+    out.bytes.insert(out.bytes.end(), entries.bytes.begin(), entries.bytes.end());
+}
+
+static bool decodeEntities(NetReader& in, const std::vector<NetEntity>* base, std::uint32_t ticks,
+                           std::uint32_t tickHz, bool bullet, std::vector<NetEntity>& result) {
+    static const std::vector<NetEntity> none;
+    const std::vector<NetEntity>& old = base ? *base : none;
+    result.clear();
+
+    // los slots quitados quedan marcados en una copia predicha de la base
+    std::uint32_t removed = in.varint();
+    if (!in.ok || removed > old.size()) return false;
+    std::vector<std::uint8_t> gone(old.size(), 0);
+    std::uint32_t slot = 0;
+    for (size_t i = 0, k = 0; k < removed; ++k) {
+        slot += in.varint();
+        while (i < old.size() && old[i].slot < slot) ++i;
+        if (!in.ok || i == old.size() || old[i].slot != slot) return false;
+        gone[i] = 1;
+    }
+
+    std::uint32_t written = in.varint();
+    if (!in.ok) return false;
+    size_t i = 0;
+    slot = 0;
+    auto keepUntil = [&](std::uint32_t limit) {
+        for (; i < old.size() && old[i].slot < limit; ++i)
+            if (!gone[i]) result.push_back(predicted(old[i], ticks, tickHz, bullet));
+    };
+    for (std::uint32_t k = 0; k < written; ++k) {
+        slot += in.varint();
+        std::uint32_t mask = in.u8();
+        if (!in.ok || slot > 0xFFFF) return false;
+        keepUntil(slot);
+        NetEntity e;
+        bool inBase = i < old.size() && old[i].slot == slot && !gone[i];
+        if (mask & FIELD_NEW) {
+            e.slot = (std::uint16_t)slot;
+            e.generation = (std::uint8_t)in.u8();
+            if (!bullet) { e.radius = (std::uint8_t)in.u8(); e.size = (std::int8_t)in.u8(); }
+        } else {
+            if (!inBase) return false;
+            e = predicted(old[i], ticks, tickHz, bullet);
+        }
+        if (i < old.size() && old[i].slot == slot) ++i;
+        if (mask & (FIELD_NEW | FIELD_X)) e.x = (std::uint16_t)in.u16();
+        if (mask & (FIELD_NEW | FIELD_Y)) e.y = (std::uint16_t)in.u16();
+        if (mask & (FIELD_NEW | FIELD_VX)) e.vx = (std::int16_t)in.u16();
+        if (mask & (FIELD_NEW | FIELD_VY)) e.vy = (std::int16_t)in.u16();
+        if (!in.ok || (!result.empty() && result.back().slot >= e.slot)) return false;
+        result.push_back(e);
+    }
+    keepUntil(0x10000);
+    return true;
+}
+
+void encodeSnapshot(NetWriter& out, const NetState& state, const NetState* baseline,
+                    std::uint32_t tickHz, NetState& sent) {
+    const std::uint32_t ticks = baseline ? state.tick - baseline->tick : 0;
+    sent.tick = state.tick;
+    sent.score = state.score;
+    sent.lives = state.lives;
+    sent.ships = state.ships;
+    out.varint((std::uint32_t)std::max(0, state.score));
+    out.u8((std::uint8_t)state.lives);
+    // las naves van siempre enteras: son pocas y cambian cada tick
+    out.u8((std::uint32_t)state.ships.size());
+    for (const NetShip& s : state.ships) writeShip(out, s);
+    encodeEntities(out, state.asteroids, baseline ? &baseline->asteroids : nullptr, ticks, tickHz, false, sent.asteroids);
+    encodeEntities(out, state.bullets, baseline ? &baseline->bullets : nullptr, ticks, tickHz, true, sent.bullets);
+}
+
+bool decodeSnapshot(NetReader& in, NetState& state, const NetState* baseline, std::uint32_t tickHz) {
+    const std::uint32_t ticks = baseline ? state.tick - baseline->tick : 0;
+    state.score = (std::int32_t)in.varint();
+    state.lives = (std::int8_t)in.u8();
+    std::uint32_t shipCount = in.u8();
+    state.ships.clear();
+    for (std::uint32_t i = 0; i < shipCount && in.ok; ++i) state.ships.push_back(readShip(in));
+    if (!in.ok) return false;
+    return decodeEntities(in, baseline ? &baseline->asteroids : nullptr, ticks, tickHz, false, state.asteroids)
+        && decodeEntities(in, baseline ? &baseline->bullets : nullptr, ticks, tickHz, true, state.bullets)
+        && in.pos == in.size;
+}
+
+void NetStats::sent(size_t bytes) {
+    bytesSent += bytes;
+    windowSent += bytes;
+    packetsSent++;
+}
+
+void NetStats::received(size_t bytes) {
+    bytesReceived += bytes;
+    windowReceived += bytes;
+    packetsReceived++;
+}
+
+void NetStats::update(std::chrono::steady_clock::time_point now) {
+    if (windowStart == std::chrono::steady_clock::time_point{}) windowStart = now;
+    float seconds = std::chrono::duration<float>(now - windowStart).count();
+    if (seconds < 1.f) return;
+    sendRate = windowSent / seconds;
+    receiveRate = windowReceived / seconds;
+    windowSent = windowReceived = 0;
+    windowStart = now;
+}
+
+void NetStats::addRttSample(float ms) {
+    rttMs = rttMs == 0.f ? ms : rttMs * 0.9f + ms * 0.1f;
+}
+
+std::string NetStats::describe() const {
+    char buf[192];
+    std::snprintf(buf, sizeof(buf), "sube %.1f KB/s, baja %.1f KB/s (%u/%u paquetes, %.1f/%.1f KB), rtt %.0f ms, instantanea %u B",
+                  sendRate / 1024.f, receiveRate / 1024.f, packetsSent, packetsReceived,
+                  bytesSent / 1024.f, bytesReceived / 1024.f, rttMs, lastSnapshotBytes);
+    std::string text = buf;
+    if (oversized) text += ", " + std::to_string(oversized) + " demasiado grandes";
+    return text;
+}
+
+std::uint32_t netMillis() {
+    return (std::uint32_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
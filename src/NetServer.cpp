@@ -0,0 +1,204 @@
+#include "NetServer.hpp"
+#include "World.hpp"
+#include "WorldSize.hpp"
+#include "Replay.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+// Un cliente que no manda nada en este tiempo se da por desconectado.
+static const float CLIENT_TIMEOUT_SECONDS = 5.f;
+// Entradas que se dejan acumular: si el cliente va adelantado se descartan las
+// más viejas en lugar de ir sumando latencia.
+static const size_t MAX_QUEUED_INPUTS = 8;
+
+bool NetServer::start(unsigned short p, float tickRate, float snapshotRate) {
+    stop();
+    if (socket.bind(p) != sf::Socket::Done) {
+        std::fprintf(stderr, "no se pudo abrir el puerto UDP %u\n", (unsigned)p);
+        return false;
+    }
+    socket.setBlocking(false);
+    tickHz = (std::uint32_t)std::max(1.f, std::round(tickRate));
+    snapshotInterval = (std::uint32_t)std::max(1.f, std::round(tickRate / std::max(1.f, snapshotRate)));
+    tick = 0;
+    buffer.resize(sf::UdpSocket::MaxDatagramSize);
+    open = true;
+    return true;
+}
+
+void NetServer::stop() {
+    if (!open) return;
+    socket.unbind();
+    clients.clear();
+    open = false;
+}
+
+NetServer::Client* NetServer::find(const sf::IpAddress& address, unsigned short p) {
+    for (Client& c : clients)
+        if (c.port == p && c.address == address) return &c;
+    return nullptr;
+}
+
+void NetServer::addClient(World& world, const sf::IpAddress& address, unsigned short p) {
+    // el id 0 es el anfitrión; se busca el primero libre
+    std::uint8_t id = 1;
+    while (id != 0 && std::any_of(clients.begin(), clients.end(), [&](const Client& c) { return c.id == id; })) ++id;
+    if (id == 0) return; // 255 clientes
+
+    Client c;
+    c.address = address;
+    c.port = p;
+    c.id = id;
+    c.heardAt = std::chrono::steady_clock::now();
+    c.history.resize(HISTORY);
+    clients.push_back(std::move(c));
+
+    World::Guest guest;
+    guest.id = id;
+    guest.ship.reset(sf::Vector2f(WORLD_WIDTH/2.f, WORLD_HEIGHT/2.f));
+    guest.ship.sprite = world.player.sprite;
+    world.guests.push_back(guest);
+    std::printf("cliente %u conectado desde %s:%u\n", (unsigned)id, address.toString().c_str(), (unsigned)p);
+}
+
+void NetServer::removeClient(World& world, size_t index) {
+    const std::uint8_t id = clients[index].id;
+    std::printf("cliente %u desconectado\n", (unsigned)id);
+    world.guests.erase(std::remove_if(world.guests.begin(), world.guests.end(),
+                                      [&](const World::Guest& g) { return g.id == id; }), world.guests.end());
+    clients.erase(clients.begin() + index);
+}
+
+void NetServer::handlePacket(World& world, const std::uint8_t* data, size_t size,
+                             const sf::IpAddress& address, unsigned short p) {
+    NetReader in(data, size);
+    const NetPacket type = (NetPacket)in.u8();
+    Client* c = find(address, p);
+    if (type == NetPacket::Hello) {
+        if (in.u32() != NET_PROTOCOL || !in.ok) return;
+        if (!c) addClient(world, address, p);
+        c = find(address, p);
+    }
+    if (!c) return;
+    c->stats.received(size);
+    c->heardAt = std::chrono::steady_clock::now();
+
+    if (type == NetPacket::Bye) {
+        removeClient(world, (size_t)(c - clients.data()));
+        return;
+    }
+    if (type != NetPacket::Input) return;
+
+    const std::uint32_t ack = in.u32();
+    const std::uint32_t clientMs = in.u32();
+    const std::uint32_t rtt = in.u16();
+    const std::uint32_t first = in.u32();
+    const std::uint32_t count = in.u8();
+    if (!in.ok || in.size - in.pos != count) return;
+    // un paquete atrasado no deshace lo que ya se confirmó
+    if (ack > c->ackedTick && ack <= tick) c->ackedTick = ack;
+    c->clientMs = clientMs;
+    if (rtt) c->stats.addRttSample((float)rtt);
+
+    // solo las que siguen a la última encolada; los huecos (más de
+    // NET_INPUT_REDUNDANCY perdidas seguidas) se rellenan con la última conocida.
+    // Las secuencias empiezan en 0 con la primera instantánea del cliente.
+    const std::uint32_t expected = c->nextInput + (std::uint32_t)c->inputs.size();
+    for (std::uint32_t i = 0; i < count; ++i) {
+        const std::uint32_t seq = first + i;
+        const std::uint8_t bits = data[in.pos + i];
+        if (seq < expected) continue;
+        // un hueco más largo que la cola (pérdida larga, o `first` corrupto o
+        // malicioso) no se rellena entrada por entrada: se salta hasta seq y
+        // solo quedan MAX_QUEUED_INPUTS de relleno, las que la cola conservaría
+        const std::uint32_t queued = c->nextInput + (std::uint32_t)c->inputs.size();
+        if (seq - queued > MAX_QUEUED_INPUTS) {
+            const std::uint8_t fill = c->inputs.empty() ? c->lastInput : c->inputs.back();
+            c->inputs.assign(MAX_QUEUED_INPUTS, fill);
+            c->nextInput = seq - (std::uint32_t)MAX_QUEUED_INPUTS;
+        }
+        while (c->nextInput + c->inputs.size() < seq)
+            c->inputs.push_back(c->inputs.empty() ? c->lastInput : c->inputs.back());
+        c->inputs.push_back(bits);
+    }
+    while (c->inputs.size() > MAX_QUEUED_INPUTS) {
+        c->inputs.pop_front();
+        c->nextInput++;
+    }
+}
+
+void NetServer::receive(World& world) {
+    if (!open) return;
+    std::size_t size = 0;
+    sf::IpAddress address;
+    unsigned short p = 0;
+    while (socket.receive(buffer.data(), buffer.size(), size, address, p) == sf::Socket::Done)
+        if (size > 0) handlePacket(world, buffer.data(), size, address, p);
+
+    const auto now = std::chrono::steady_clock::now();
+    for (size_t i = clients.size(); i-- > 0;)
+        if (std::chrono::duration<float>(now - clients[i].heardAt).count() > CLIENT_TIMEOUT_SECONDS)
+            removeClient(world, i);
+
+    // una entrada por tick y cliente; si no llegó, se repite la última sin
+    // consumir su número (la predicción del cliente corrige la diferencia)
+    for (Client& c : clients) {
+        if (!c.inputs.empty()) {
+            c.lastInput = c.inputs.front();
+            c.inputs.pop_front();
+            c.nextInput++;
+        }
+        for (World::Guest& g : world.guests)
+            if (g.id == c.id) g.input = Replay::unpackInput(c.lastInput);
+        c.stats.update(now);
+    }
+}
+
+void NetServer::send(const World& world) {
+    if (!open) return;
+    tick++;
+    if (clients.empty() || tick % snapshotInterval != 0) return;
+
+    state.capture(world, tick);
+    const auto now = std::chrono::steady_clock::now();
+    for (Client& c : clients) {
+        // la base es lo que el cliente reconstruyó de la instantánea confirmada, si aún se guarda
+        const NetState* baseline = nullptr;
+        if (c.ackedTick != 0 && tick - c.ackedTick < HISTORY && c.history[c.ackedTick % HISTORY].tick == c.ackedTick)
+            baseline = &c.history[c.ackedTick % HISTORY];
+
+        packet.bytes.clear();
+        packet.u8((std::uint32_t)NetPacket::Snapshot);
+        packet.u32(tick);
+        packet.u32(baseline ? baseline->tick : 0);
+        packet.u16(tickHz);
+        packet.u8(c.id);
+        packet.u32(c.nextInput);
+        packet.u32(c.clientMs);
+        packet.u16((std::uint32_t)std::min<long long>(65535,
+            std::chrono::duration_cast<std::chrono::milliseconds>(now - c.heardAt).count()));
+        NetState& sent = c.history[tick % HISTORY];
+        encodeSnapshot(packet, state, baseline, tickHz, sent);
+
+        if (packet.bytes.size() > NET_MAX_DATAGRAM) {
+            sent.tick = 0; // no sirve de base
+            c.stats.oversized++;
+            continue;
+        }
+        if (socket.send(packet.bytes.data(), packet.bytes.size(), c.address, c.port) == sf::Socket::Done) {
+            c.stats.sent(packet.bytes.size());
+            c.stats.lastSnapshotBytes = (std::uint32_t)packet.bytes.size();
+        }
+    }
+}
+
+std::string NetServer::describe() const {
+    std::string text;
+    for (const Client& c : clients) {
+        char head[96];
+        std::snprintf(head, sizeof(head), "cliente %u (%s:%u): ", (unsigned)c.id, c.address.toString().c_str(), (unsigned)c.port);
+        text += head + c.stats.describe() + "\n";
+    }
+    return text;
+}
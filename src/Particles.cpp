@@ -0,0 +1,97 @@
+#include "Particles.hpp"
+#include <algorithm>
+#include <cmath>
+
+// Frenado por segundo: las partículas se abren rápido y se quedan flotando.
+static const float PARTICLE_DRAG = 1.8f;
+
+void ParticleSystem::init(size_t capacity) {
+    max = capacity;
+    for (std::vector<float>* v : {&x, &y, &vx, &vy, &life, &invLife, &size}) {
+        v->clear();
+        v->reserve(capacity);
+    }
+    color.clear();
+    color.reserve(capacity);
+}
+
+void ParticleSystem::clear() {
+    for (std::vector<float>* v : {&x, &y, &vx, &vy, &life, &invLife, &size}) v->clear();
+    color.clear();
+}
+
+void ParticleSystem::emit(const Burst& b, unsigned count) {
+    count = (unsigned)std::min<size_t>(count, max - live());
+    for (unsigned i = 0; i < count; ++i) {
+        float ang = (b.angle + rng.uniform(-b.spread, b.spread)) * 3.14159f/180.f;
+        float speed = rng.uniform(b.minSpeed, b.maxSpeed);
+        float seconds = rng.uniform(b.minLife, b.maxLife);
+        x.push_back(b.origin.x);
+        y.push_back(b.origin.y);
+        vx.push_back(b.baseVelocity.x + std::cos(ang) * speed);
+        vy.push_back(b.baseVelocity.y + std::sin(ang) * speed);
+        life.push_back(seconds);
+        invLife.push_back(1.f / seconds);
+        size.push_back(b.size * rng.uniform(0.7f, 1.3f));
+        color.push_back(b.color);
+    }
+}
+
+void ParticleSystem::update(float dt) {
+    size_t n = live();
+    if (n == 0) return;
+    const float drag = std::max(0.f, 1.f - PARTICLE_DRAG * dt);
+    float* __restrict px = x.data();
+    float* __restrict py = y.data();
+    float* __restrict pvx = vx.data();
+    float* __restrict pvy = vy.data();
+    float* __restrict pl = life.data();
+    // bucle sin saltos sobre arreglos contiguos: el compilador lo vectoriza
+    for (size_t i = 0; i < n; ++i) {
+        px[i] += pvx[i] * dt;
+        py[i] += pvy[i] * dt;
+        pvx[i] *= drag;
+        pvy[i] *= drag;
+        pl[i] -= dt;
+    }
+    // quitar las agotadas cambiándolas por la última viva
+    for (size_t i = 0; i < n;) {
+        if (pl[i] > 0.f) { ++i; continue; }
+        --n;
+        x[i] = x[n]; y[i] = y[n]; vx[i] = vx[n]; vy[i] = vy[n];
+        life[i] = life[n]; invLife[i] = invLife[n]; size[i] = size[n]; color[i] = color[n];
+    }
+    for (std::vector<float>* v : {&x, &y, &vx, &vy, &life, &invLife, &size}) v->resize(n);
+    color.resize(n);
+}
+
+void ParticleSystem::copyFrom(const ParticleSystem& o) {
+    // la asignación de vectores reutiliza la memoria ya pedida
+    x = o.x; y = o.y; vx = o.vx; vy = o.vy;
+    life = o.life; invLife = o.invLife; size = o.size; color = o.color;
+    max = o.max;
+}
+
+unsigned ParticleSystem::draw(sf::RenderTarget& target, sf::VertexArray& vertices, float rewind) const {
+    if (live() == 0) return 0;
+    buildVertices(vertices, rewind);
+    target.draw(vertices);
+    return 1;
+}
+
+void ParticleSystem::buildVertices(sf::VertexArray& vertices, float rewind) const {
+    size_t n = live();
+    vertices.setPrimitiveType(sf::Triangles);
+    vertices.resize(n * 6);
+    for (size_t i = 0; i < n; ++i) {
+        float cx = x[i] - vx[i] * rewind, cy = y[i] - vy[i] * rewind;
+        float h = size[i] * 0.5f;
+        // se desvanecen con la vida que les queda
+        sf::Color c = color[i];
+        c.a = (sf::Uint8)(c.a * std::min(1.f, life[i] * invLife[i]));
+        sf::Vertex* v = &vertices[i * 6];
+        v[0].position = {cx - h, cy - h}; v[1].position = {cx + h, cy - h}; v[2].position = {cx + h, cy + h};
+        v[3].position = {cx - h, cy - h}; v[4].position = {cx + h, cy + h}; v[5].position = {cx - h, cy + h};
+        for (int k = 0; k < 6; ++k) v[k].color = c;
+    }
+}
@@ -0,0 +1,135 @@
+#include "Profiler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+// Límites de lo grabado para volcar: ~1 h de frames a 60 FPS y 1M de zonas (~16 MB).
+static const size_t MAX_RECORDED_FRAMES = 216000;
+static const size_t MAX_RECORDED_EVENTS = 1u << 20;
+
+const char* profileZoneName(ProfileZone zone) {
+    static const char* names[] = {
+        "frame",
+        "eventos",
+        "update", "  entrada", "  integracion", "  colisiones", "  generacion", "  musica",
+        "render", "  fondo", "  entidades", "  hud"
+    };
+    return names[(int)zone];
+}
+
+Profiler::Profiler(size_t frameWindow)
+    : window(std::max<size_t>(1, frameWindow)), history(window * ZONE_COUNT, 0.f),
+      origin(Clock::now()), frameStart(origin), scratch(window) {}
+
+void Profiler::beginFrame() {
+    current.fill(0.0);
+    frameStart = Clock::now();
+}
+
+void Profiler::endFrame() {
+    add(ProfileZone::Frame, frameStart, Clock::now());
+    float* row = &history[head * ZONE_COUNT];
+    for (size_t z = 0; z < ZONE_COUNT; ++z) row[z] = (float)current[z];
+    head = (head + 1) % window;
+    filled = std::min(filled + 1, window);
+    if (recording && frameLog.size() + ZONE_COUNT <= frameLog.capacity())
+        frameLog.insert(frameLog.end(), row, row + ZONE_COUNT);
+}
+
+void Profiler::add(ProfileZone zone, Clock::time_point start, Clock::time_point end) {
+    current[(size_t)zone] += std::chrono::duration<double, std::milli>(end - start).count();
+    if (recording && events.size() < events.capacity()) {
+        TraceEvent e;
+        e.zone = (std::uint8_t)zone;
+        e.startUs = std::chrono::duration<double, std::micro>(start - origin).count();
+        e.durationUs = std::chrono::duration<float, std::micro>(end - start).count();
+        events.push_back(e);
+    }
+}
+
+Profiler::Stats Profiler::stats(ProfileZone zone) const {
+    Stats s;
+    if (filled == 0) return s;
+    for (size_t i = 0; i < filled; ++i) scratch[i] = history[i * ZONE_COUNT + (size_t)zone];
+    auto first = scratch.begin(), last = scratch.begin() + filled;
+    s.minMs = *std::min_element(first, last);
+    double sum = 0.0;
+    for (auto it = first; it != last; ++it) sum += *it;
+    s.avgMs = sum / filled;
+    size_t k = (size_t)std::ceil(0.99 * filled) - 1;
+    std::nth_element(first, first + k, last);
+    s.p99Ms = scratch[k];
+    return s;
+}
+
+void Profiler::markStartup() {
+    startup = std::chrono::duration<double, std::milli>(Clock::now() - origin).count();
+}
+
+std::string Profiler::table() const {
+    std::string out;
+    char line[96];
+    if (startup > 0.0) {
+        std::snprintf(line, sizeof(line), "arranque: %.1f ms\n", startup);
+        out += line;
+    }
+    std::snprintf(line, sizeof(line), "%-14s %7s %7s %7s  (ms, %zu frames)\n", "zona", "min", "media", "p99", filled);
+    out += line;
+    for (size_t z = 0; z < ZONE_COUNT; ++z) {
+        Stats s = stats((ProfileZone)z);
+        std::snprintf(line, sizeof(line), "%-14s %7.3f %7.3f %7.3f\n",
+                      profileZoneName((ProfileZone)z), s.minMs, s.avgMs, s.p99Ms);
+        out += line;
+    }
+    return out;
+}
+
+void Profiler::setRecording(bool enabled) {
+    recording = enabled;
+    if (enabled) {
+        events.reserve(MAX_RECORDED_EVENTS);
+        frameLog.reserve(MAX_RECORDED_FRAMES * ZONE_COUNT);
+    }
+}
+
+bool Profiler::write(const std::string& path) const {
+    bool json = path.size() >= 5 && path.compare(path.size() - 5, 5, ".json") == 0;
+    return json ? writeTrace(path) : writeCsv(path);
+}
+
+bool Profiler::writeCsv(const std::string& path) const {
+    FILE* f = std::fopen(path.c_str(), "w");
+    if (!f) return false;
+    std::fprintf(f, "frame");
+    for (size_t z = 0; z < ZONE_COUNT; ++z) {
+        // sin la sangría de las zonas anidadas
+        const char* name = profileZoneName((ProfileZone)z);
+        while (*name == ' ') name++;
+        std::fprintf(f, ",%s_ms", name);
+    }
+    std::fprintf(f, "\n");
+    for (size_t i = 0; i * ZONE_COUNT < frameLog.size(); ++i) {
+        std::fprintf(f, "%zu", i);
+        for (size_t z = 0; z < ZONE_COUNT; ++z) std::fprintf(f, ",%.4f", frameLog[i * ZONE_COUNT + z]);
+        std::fprintf(f, "\n");
+    }
+    return std::fclose(f) == 0;
+}
+
+bool Profiler::writeTrace(const std::string& path) const {
+    FILE* f = std::fopen(path.c_str(), "w");
+    if (!f) return false;
+    std::fprintf(f, "{\"traceEvents\":[\n");
+    if (startup > 0.0)
+        std::fprintf(f, "{\"name\":\"arranque\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":0,\"dur\":%.3f}%s\n",
+                     startup * 1000.0, events.empty() ? "" : ",");
+    for (size_t i = 0; i < events.size(); ++i) {
+        const TraceEvent& e = events[i];
+        const char* name = profileZoneName((ProfileZone)e.zone);
+        while (*name == ' ') name++;
+        std::fprintf(f, "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f}%s\n",
+                     name, e.startUs, (double)e.durationUs, i + 1 < events.size() ? "," : "");
+    }
+    std::fprintf(f, "],\"displayTimeUnit\":\"ms\"}\n");
+    return std::fclose(f) == 0;
+}
@@ -0,0 +1,111 @@
+#include "Replay.hpp"
+#include <cstdio>
+#include <cstring>
+
+static const char REPLAY_MAGIC[4] = {'A','S','T','R'};
+// 2: colisiones barridas; las grabaciones anteriores ya no dan la misma partida
+static const std::uint32_t REPLAY_VERSION = 2;
+
+void Replay::begin(std::uint64_t s, float tickDt) {
+    seed = s;
+    dt = tickDt;
+    finalChecksum = 0;
+    inputs.clear();
+    inputs.reserve(60 * 60 * 60);
+}
+
+std::uint8_t Replay::packInput(const ShipInput& in) {
+    return (std::uint8_t)((in.left ? 1 : 0) | (in.right ? 2 : 0) | (in.thrust ? 4 : 0) | (in.shoot ? 8 : 0));
+}
+
+ShipInput Replay::unpackInput(std::uint8_t bits) {
+    ShipInput in;
+    in.left = (bits & 1) != 0;
+    in.right = (bits & 2) != 0;
+    in.thrust = (bits & 4) != 0;
+    in.shoot = (bits & 8) != 0;
+    return in;
+}
+
+// Enteros little-endian byte a byte, igual en cualquier plataforma.
+static void putInt(std::vector<std::uint8_t>& out, std::uint64_t v, int bytes) {
+    for (int i = 0; i < bytes; ++i) out.push_back((std::uint8_t)(v >> (8*i)));
+}
+
+static bool getInt(const std::vector<std::uint8_t>& in, size_t& pos, std::uint64_t& v, int bytes) {
+    if (pos + bytes > in.size()) return false;
+    v = 0;
+    for (int i = 0; i < bytes; ++i) v |= (std::uint64_t)in[pos++] << (8*i);
+    return true;
+}
+
+static void putVarint(std::vector<std::uint8_t>& out, std::uint32_t v) {
+    while (v >= 0x80) { out.push_back((std::uint8_t)(v | 0x80)); v >>= 7; }
+    out.push_back((std::uint8_t)v);
+}
+
+static bool getVarint(const std::vector<std::uint8_t>& in, size_t& pos, std::uint32_t& v) {
+    v = 0;
+    for (int shift = 0; shift < 35 && pos < in.size(); shift += 7) {
+        std::uint8_t b = in[pos++];
+        v |= (std::uint32_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+bool Replay::save(const std::string& path) const {
+    std::vector<std::uint8_t> out(REPLAY_MAGIC, REPLAY_MAGIC + 4);
+    std::uint32_t dtBits;
+    std::memcpy(&dtBits, &dt, sizeof(dtBits));
+    putInt(out, REPLAY_VERSION, 4);
+    putInt(out, seed, 8);
+    putInt(out, dtBits, 4);
+    putInt(out, inputs.size(), 4);
+    putInt(out, finalChecksum, 8);
+    for (size_t i = 0; i < inputs.size();) {
+        size_t run = 1;
+        while (i + run < inputs.size() && inputs[i + run] == inputs[i]) run++;
+        out.push_back(inputs[i]);
+        putVarint(out, (std::uint32_t)run);
+        i += run;
+    }
+    FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) return false;
+    bool ok = std::fwrite(out.data(), 1, out.size(), f) == out.size();
+    return std::fclose(f) == 0 && ok;
+}
+
+bool Replay::load(const std::string& path) {
+    FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f) return false;
+    std::vector<std::uint8_t> in;
+    std::uint8_t buf[4096];
+    size_t n;
+    while ((n = std::fread(buf, 1, sizeof(buf), f)) > 0) in.insert(in.end(), buf, buf + n);
+    std::fclose(f);
+
+    if (in.size() < 4 || std::memcmp(in.data(), REPLAY_MAGIC, 4) != 0) return false;
+    size_t pos = 4;
+    std::uint64_t version, s, dtBits, count, check;
+    if (!getInt(in, pos, version, 4) || version != REPLAY_VERSION) return false;
+    if (!getInt(in, pos, s, 8) || !getInt(in, pos, dtBits, 4) || !getInt(in, pos, count, 4) || !getInt(in, pos, check, 8))
+        return false;
+
+    std::vector<std::uint8_t> ticks;
+    ticks.reserve(count);
+    while (pos < in.size()) {
+        std::uint8_t bits = in[pos++];
+        std::uint32_t run;
+        if (!getVarint(in, pos, run) || ticks.size() + run > count) return false;
+        ticks.insert(ticks.end(), run, bits);
+    }
+    if (ticks.size() != count) return false;
+
+    std::uint32_t dt32 = (std::uint32_t)dtBits;
+    std::memcpy(&dt, &dt32, sizeof(dt));
+    seed = s;
+    finalChecksum = check;
+    inputs.swap(ticks);
+    return true;
+}
@@ -0,0 +1,146 @@
+#include "RewindBuffer.hpp"
+#include "World.hpp"
+#include <algorithm>
+
+// Ceros seguidos a partir de los cuales conviene cortar el tramo literal.
+static const size_t MIN_ZERO_RUN = 4;
+
+static void putVarint(std::vector<std::uint8_t>& out, size_t v) {
+    while (v >= 0x80) { out.push_back((std::uint8_t)(v | 0x80)); v >>= 7; }
+    out.push_back((std::uint8_t)v);
+}
+
+static size_t getVarint(const std::uint8_t*& p) {
+    size_t v = 0;
+    for (int shift = 0;; shift += 7) {
+        std::uint8_t b = *p++;
+        v |= (size_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) return v;
+    }
+}
+
+// Delta de `cur` contra `prev`: tamaño de `cur` y pares (ceros, literales)
+// con los literales ya en XOR; lo que pasa del final de `prev` va contra cero.
+static void encodeDelta(const std::vector<std::uint8_t>& prev, const std::vector<std::uint8_t>& cur,
+                        std::vector<std::uint8_t>& out) {
+    out.clear();
+    putVarint(out, cur.size());
+    auto diff = [&](size_t i) -> std::uint8_t { return cur[i] ^ (i < prev.size() ? prev[i] : 0); };
+    size_t i = 0;
+    while (i < cur.size()) {
+        size_t zeros = 0;
+        while (i + zeros < cur.size() && diff(i + zeros) == 0) zeros++;
+        i += zeros;
+        if (i == cur.size()) { putVarint(out, zeros); putVarint(out, 0); break; }
+        // el literal sigue hasta una racha de ceros que valga la pena
+        size_t end = i, run = 0;
+        while (end + run < cur.size() && run < MIN_ZERO_RUN) {
+            if (diff(end + run) == 0) run++;
+            else { end += run + 1; run = 0; }
+        }
+        putVarint(out, zeros);
+        putVarint(out, end - i);
+        for (size_t k = i; k < end; ++k) out.push_back(diff(k));
+        i = end;
+    }
+}
+
+static void applyDelta(std::vector<std::uint8_t>& state, const std::vector<std::uint8_t>& delta) {
+    const std::uint8_t* p = delta.data();
+    const std::uint8_t* end = p + delta.size();
+    const size_t size = getVarint(p);
+    state.resize(size, 0);
+    size_t i = 0;
+    while (p < end) {
+        i += getVarint(p);
+        const size_t n = getVarint(p);
+        for (size_t k = 0; k < n; ++k) state[i + k] ^= *p++;
+        i += n;
+    }
+}
+
+void RewindBuffer::configure(unsigned everyTicks, size_t capacity, unsigned keyframes) {
+    interval = std::max(1u, everyTicks);
+    keyframeEvery = std::max(1u, keyframes);
+    entries.assign(std::max<size_t>(1, capacity), Entry());
+    first = used = 0;
+}
+
+void RewindBuffer::reset(const World& world) {
+    if (entries.empty()) configure(interval, 1);
+    first = used = 0;
+    now = 0;
+    sinceKeyframe = 0;
+    push(world);
+}
+
+void RewindBuffer::record(const World& world) {
+    if (entries.empty()) return;
+    now++;
+    if (now % interval == 0) push(world);
+}
+
+void RewindBuffer::push(const World& world) {
+    // la más vieja se va; si la que queda primera es un delta, pasa a estado entero
+    if (used == entries.size()) {
+        first = (first + 1) % entries.size();
+        used--;
+        if (used > 0 && !at(0).keyframe) {
+            decode(0, promoted);
+            at(0).data.swap(promoted);
+            at(0).keyframe = true;
+        }
+    }
+    scratch.capture(world);
+    Entry& e = at(used);
+    e.tick = now;
+    e.keyframe = used == 0 || sinceKeyframe + 1 >= keyframeEvery;
+    if (e.keyframe) {
+        e.data = scratch.bytes;
+        sinceKeyframe = 0;
+    } else {
+        encodeDelta(current.bytes, scratch.bytes, e.data);
+        sinceKeyframe++;
+    }
+    std::swap(current, scratch);
+    used++;
+}
+
+void RewindBuffer::decode(size_t i, std::vector<std::uint8_t>& out) const {
+    size_t k = i;
+    while (!at(k).keyframe) k--; // la primera siempre es entera
+    out = at(k).data;
+    for (++k; k <= i; ++k) applyDelta(out, at(k).data);
+}
+
+long long RewindBuffer::rewind(World& world, size_t ticks) {
+    if (used == 0) return -1;
+    const std::uint64_t target = now > ticks ? now - ticks : 0;
+    size_t i = used - 1;
+    while (i > 0 && at(i).tick > target) i--;
+    decode(i, current.bytes);
+    if (!current.restore(world)) return -1;
+    // lo posterior ya no ocurrió; la próxima captura sigue desde aquí
+    used = i + 1;
+    now = at(i).tick;
+    sinceKeyframe = 0;
+    for (size_t k = i; !at(k).keyframe; --k) sinceKeyframe++;
+    return (long long)now;
+}
+
+size_t RewindBuffer::storedBytes() const {
+    size_t total = 0;
+    for (size_t i = 0; i < used; ++i) total += at(i).data.size();
+    return total;
+}
+
+size_t RewindBuffer::averageDeltaBytes() const {
+    size_t total = 0, deltas = 0;
+    for (size_t i = 0; i < used; ++i)
+        if (!at(i).keyframe) { total += at(i).data.size(); deltas++; }
+    return deltas ? total / deltas : 0;
+}
+
+float RewindBuffer::secondsAvailable(float tickDt) const {
+    return used == 0 ? 0.f : (now - at(0).tick) * tickDt;
+}
@@ -0,0 +1,75 @@
+#include "SfxPool.hpp"
+#include <algorithm>
+#include <cmath>
+
+SfxPool::SfxPool(size_t count) : voices(std::max<size_t>(1, count)) {}
+
+void SfxPool::configure(Sfx id, const sf::SoundBuffer* buffer, float gain, int priority, unsigned maxInstances) {
+    Effect& e = effects[(size_t)id];
+    e.buffer = buffer;
+    e.gain = gain;
+    e.priority = priority;
+    e.maxInstances = std::max(1u, maxInstances);
+}
+
+void SfxPool::setVolume(float v) {
+    volume = v;
+}
+
+void SfxPool::flush() {
+    for (size_t i = 0; i < SFX_COUNT; ++i) {
+        if (pending[i] > 0) play((Sfx)i, pending[i]);
+        pending[i] = 0;
+    }
+}
+
+unsigned SfxPool::activeVoices() const {
+    unsigned n = 0;
+    for (const Voice& v : voices)
+        if (v.sound.getStatus() == sf::Sound::Playing) n++;
+    return n;
+}
+
+int SfxPool::pickVoice(Sfx id) {
+    const Effect& e = effects[(size_t)id];
+    int free = -1, oldestSame = -1, victim = -1;
+    unsigned instances = 0;
+    for (int i = 0; i < (int)voices.size(); ++i) {
+        const Voice& v = voices[i];
+        if (v.sound.getStatus() != sf::Sound::Playing) {
+            if (free < 0) free = i;
+            continue;
+        }
+        if (v.effect == (unsigned)id) {
+            instances++;
+            if (oldestSame < 0 || v.started < voices[oldestSame].started) oldestSame = i;
+        }
+        // candidata a robar: menor prioridad y, a igual prioridad, la más antigua
+        const Effect& other = effects[v.effect];
+        if (other.priority > e.priority) continue;
+        if (victim < 0) { victim = i; continue; }
+        const Effect& best = effects[voices[victim].effect];
+        if (other.priority < best.priority || (other.priority == best.priority && v.started < voices[victim].started))
+            victim = i;
+    }
+    // tope por efecto: se reinicia su instancia más antigua en lugar de sumar otra
+    if (instances >= e.maxInstances) return oldestSame;
+    if (free >= 0) return free;
+    return victim;
+}
+
+void SfxPool::play(Sfx id, unsigned count) {
+    const Effect& e = effects[(size_t)id];
+    if (!e.buffer) return;
+    int i = pickVoice(id);
+    if (i < 0) return;
+    Voice& v = voices[i];
+    v.sound.stop();
+    v.sound.setBuffer(*e.buffer);
+    // varios iguales en el mismo tick: algo más fuerte, no N veces
+    float boost = 1.f + 0.25f * std::log2((float)count);
+    v.sound.setVolume(std::min(100.f, volume * e.gain * boost));
+    v.sound.play();
+    v.effect = (unsigned)id;
+    v.started = ++playCount;
+}
@@ -1,40 +1,45 @@
 #include "Ship.hpp"
-#include <SFML/Window/Keyboard.hpp>
+#include "Interpolation.hpp"
+#include "SpriteBatch.hpp"
+#include "WorldSize.hpp"
 #include <cmath>
 
-static const int WIDTH = 1280;
-static const int HEIGHT = 720;
-
 Ship::Ship() {
-    position = {WIDTH/2.f, HEIGHT/2.f};
+    position = {WORLD_WIDTH/2.f, WORLD_HEIGHT/2.f};
+    prevPosition = position;
     velocity = {0.f,0.f};
 }
 
 void Ship::reset(const sf::Vector2f& pos) {
-    position = pos; velocity = {0.f,0.f}; angle = -90.f; alive = true;
+    position = pos; velocity = {0.f,0.f}; angle = -90.f; alive = true; thrusting = false;
+    prevPosition = position; prevAngle = angle;
 }
 
-void Ship::handleInput() {
+void Ship::handleInput(const ShipInput& input, float dt) {
+    // handleInput es lo primero de cada tick: guardar el estado anterior para interpolar
+    prevPosition = position;
+    prevAngle = angle;
     // rotación
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Left)) angle -= rotationSpeed * (1.f/60.f);
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Right)) angle += rotationSpeed * (1.f/60.f);
+    if (input.left) angle -= rotationSpeed * dt;
+    if (input.right) angle += rotationSpeed * dt;
     // empuje
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Up)) {
+    thrusting = input.thrust;
+    if (input.thrust) {
         float rad = angle * 3.14159f/180.f;
-        velocity.x += std::cos(rad) * thrust * (1.f/60.f);
-        velocity.y += std::sin(rad) * thrust * (1.f/60.f);
+        velocity.x += std::cos(rad) * thrust * dt;
+        velocity.y += std::sin(rad) * thrust * dt;
     }
 }
 
 void Ship::update(float dt) {
-    // atenuación simple
-    velocity *= 0.995f;
+    // atenuación simple, independiente del tick (equivale a 0.995 dos veces por frame a 60 Hz)
+    velocity *= std::pow(0.995f, 120.f * dt);
     position += velocity * dt;
     // envolver en pantalla (wrap-around)
-    if (position.x < 0) position.x += WIDTH;
-    if (position.x > WIDTH) position.x -= WIDTH;
-    if (position.y < 0) position.y += HEIGHT;
-    if (position.y > HEIGHT) position.y -= HEIGHT;
+    if (position.x < 0) position.x += WORLD_WIDTH;
+    if (position.x > WORLD_WIDTH) position.x -= WORLD_WIDTH;
+    if (position.y < 0) position.y += WORLD_HEIGHT;
+    if (position.y > WORLD_HEIGHT) position.y -= WORLD_HEIGHT;
     timeSinceShot += dt;
 }
 
@@ -42,6 +47,7 @@ Bullet Ship::shoot() {
     Bullet b;
     float rad = angle * 3.14159f/180.f;
     b.position = position + sf::Vector2f(std::cos(rad)*radius, std::sin(rad)*radius);
+    b.prevPosition = b.position;
     b.velocity = velocity + sf::Vector2f(std::cos(rad)*400.f, std::sin(rad)*400.f);
     b.lifetime = 2.0f;
     b.alive = true;
@@ -49,17 +55,17 @@ Bullet Ship::shoot() {
     return b;
 }
 
-void Ship::draw(sf::RenderTarget& target) const {
+void Ship::draw(SpriteBatch& batch, float alpha) const {
     // Dibujar la nave como un triángulo blanco sólido independientemente de la textura.
-    sf::ConvexShape tri; tri.setPointCount(3);
-    tri.setPoint(0, sf::Vector2f(0.f, -radius));
-    tri.setPoint(1, sf::Vector2f(-radius*0.6f, radius));
-    tri.setPoint(2, sf::Vector2f(radius*0.6f, radius));
-    tri.setOrigin(0.f, 0.f);
-    tri.setPosition(position);
-    tri.setRotation(angle+90.f);
-    tri.setFillColor(sf::Color::White);
-    tri.setOutlineColor(sf::Color(180,180,180));
-    tri.setOutlineThickness(1.f);
-    target.draw(tri);
+    sf::Vector2f pos = interpolatePosition(prevPosition, position, alpha);
+    float rad = (prevAngle + (angle - prevAngle) * alpha + 90.f) * 3.14159f/180.f;
+    float c = std::cos(rad), s = std::sin(rad);
+    auto corner = [&](float x, float y, float grow) {
+        x *= grow; y *= grow;
+        return sf::Vector2f(pos.x + x*c - y*s, pos.y + x*s + y*c);
+    };
+    // contorno gris: el mismo triángulo un poco más grande, debajo del relleno
+    float outline = (radius + 1.f) / radius;
+    batch.addTriangle(corner(0.f, -radius, outline), corner(-radius*0.6f, radius, outline), corner(radius*0.6f, radius, outline), sf::Color(180,180,180));
+    batch.addTriangle(corner(0.f, -radius, 1.f), corner(-radius*0.6f, radius, 1.f), corner(radius*0.6f, radius, 1.f), sf::Color::White);
 }
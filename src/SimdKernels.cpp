@@ -0,0 +1,132 @@
+#include "SimdKernels.hpp"
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define ASTEROIDS_SSE2 1
+#endif
+
+// Parte escalar: el resto que no llena un registro, o todo si no hay SIMD.
+static inline void wrapScalar(float& p, float m, float limit) {
+    if (p < -m) p = limit + m;
+    if (p > limit + m) p = -m;
+}
+
+static void integrateWrapScalar(float* x, float* y, const float* vx, const float* vy,
+                                const float* margin, float uniformMargin,
+                                std::size_t begin, std::size_t n, float dt, float width, float height) {
+    for (std::size_t i = begin; i < n; ++i) {
+        float m = margin ? margin[i] : uniformMargin;
+        x[i] += vx[i] * dt;
+        y[i] += vy[i] * dt;
+        wrapScalar(x[i], m, width);
+        wrapScalar(y[i], m, height);
+    }
+}
+
+#if defined(__AVX__)
+// p < -m -> limit+m ; p > limit+m -> -m
+static inline __m256 wrap8(__m256 p, __m256 m, __m256 limit) {
+    __m256 negM = _mm256_sub_ps(_mm256_setzero_ps(), m);
+    __m256 hi = _mm256_add_ps(limit, m);
+    p = _mm256_blendv_ps(p, hi, _mm256_cmp_ps(p, negM, _CMP_LT_OQ));
+    return _mm256_blendv_ps(p, negM, _mm256_cmp_ps(p, hi, _CMP_GT_OQ));
+}
+#elif defined(ASTEROIDS_SSE2)
+static inline __m128 select4(__m128 mask, __m128 a, __m128 b) {
+    return _mm_or_ps(_mm_and_ps(mask, b), _mm_andnot_ps(mask, a));
+}
+static inline __m128 wrap4(__m128 p, __m128 m, __m128 limit) {
+    __m128 negM = _mm_sub_ps(_mm_setzero_ps(), m);
+    __m128 hi = _mm_add_ps(limit, m);
+    p = select4(_mm_cmplt_ps(p, negM), p, hi);
+    return select4(_mm_cmpgt_ps(p, hi), p, negM);
+}
+#endif
+
+static void integrateWrapImpl(float* x, float* y, const float* vx, const float* vy,
+                              const float* margin, float uniformMargin,
+                              std::size_t n, float dt, float width, float height) {
+    std::size_t i = 0;
+#if defined(__AVX__)
+    const __m256 vdt = _mm256_set1_ps(dt), w = _mm256_set1_ps(width), h = _mm256_set1_ps(height);
+    const __m256 um = _mm256_set1_ps(uniformMargin);
+    for (; i + 8 <= n; i += 8) {
+        __m256 m = margin ? _mm256_loadu_ps(margin + i) : um;
+        __m256 px = _mm256_add_ps(_mm256_loadu_ps(x + i), _mm256_mul_ps(_mm256_loadu_ps(vx + i), vdt));
+        __m256 py = _mm256_add_ps(_mm256_loadu_ps(y + i), _mm256_mul_ps(_mm256_loadu_ps(vy + i), vdt));
+        _mm256_storeu_ps(x + i, wrap8(px, m, w));
+        _mm256_storeu_ps(y + i, wrap8(py, m, h));
+    }
+#elif defined(ASTEROIDS_SSE2)
+    const __m128 vdt = _mm_set1_ps(dt), w = _mm_set1_ps(width), h = _mm_set1_ps(height);
+    const __m128 um = _mm_set1_ps(uniformMargin);
+    for (; i + 4 <= n; i += 4) {
+        __m128 m = margin ? _mm_loadu_ps(margin + i) : um;
+        __m128 px = _mm_add_ps(_mm_loadu_ps(x + i), _mm_mul_ps(_mm_loadu_ps(vx + i), vdt));
+        __m128 py = _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(_mm_loadu_ps(vy + i), vdt));
+        _mm_storeu_ps(x + i, wrap4(px, m, w));
+        _mm_storeu_ps(y + i, wrap4(py, m, h));
+    }
+#endif
+    integrateWrapScalar(x, y, vx, vy, margin, uniformMargin, i, n, dt, width, height);
+}
+
+void integrateWrap(float* x, float* y, const float* vx, const float* vy,
+                   const float* margin, std::size_t n, float dt, float width, float height) {
+    integrateWrapImpl(x, y, vx, vy, margin, 0.f, n, dt, width, height);
+}
+
+void integrateWrapUniform(float* x, float* y, const float* vx, const float* vy,
+                          float margin, std::size_t n, float dt, float width, float height) {
+    integrateWrapImpl(x, y, vx, vy, nullptr, margin, n, dt, width, height);
+}
+
+std::size_t tickLifetimes(float* lifetime, std::uint8_t* alive, std::size_t n, float dt, std::uint32_t* expired) {
+    std::size_t i = 0, count = 0;
+    // revisa las `lanes` entidades desde `base` cuyo bit en `mask` (tiempo > 0) está apagado
+    auto collect = [&](std::size_t base, int mask, int lanes) {
+        for (int k = 0; k < lanes; ++k) {
+            if (alive[base + k] && !((mask >> k) & 1)) {
+                alive[base + k] = 0;
+                expired[count++] = (std::uint32_t)(base + k);
+            }
+        }
+    };
+#if defined(__AVX__)
+    const __m256 vdt = _mm256_set1_ps(dt), zero = _mm256_setzero_ps();
+    for (; i + 8 <= n; i += 8) {
+        __m256 l = _mm256_sub_ps(_mm256_loadu_ps(lifetime + i), vdt);
+        _mm256_storeu_ps(lifetime + i, l);
+        int mask = _mm256_movemask_ps(_mm256_cmp_ps(l, zero, _CMP_GT_OQ));
+        if (mask != 0xFF) collect(i, mask, 8);
+    }
+#elif defined(ASTEROIDS_SSE2)
+    const __m128 vdt = _mm_set1_ps(dt), zero = _mm_setzero_ps();
+    for (; i + 4 <= n; i += 4) {
+        __m128 l = _mm_sub_ps(_mm_loadu_ps(lifetime + i), vdt);
+        _mm_storeu_ps(lifetime + i, l);
+        int mask = _mm_movemask_ps(_mm_cmpgt_ps(l, zero));
+        if (mask != 0xF) collect(i, mask, 4);
+    }
+#endif
+    for (; i < n; ++i) {
+        lifetime[i] -= dt;
+        if (alive[i] && lifetime[i] <= 0.f) {
+            alive[i] = 0;
+            expired[count++] = (std::uint32_t)i;
+        }
+    }
+    return count;
+}
+
+const char* simdPathName() {
+#if defined(__AVX__)
+    return "avx";
+#elif defined(ASTEROIDS_SSE2)
+    return "sse2";
+#else
+    return "escalar";
+#endif
+}
@@ -0,0 +1,131 @@
+#include "SoakMonitor.hpp"
+#include "World.hpp"
+#include <algorithm>
+#include <cstdio>
+
+#ifdef _WIN32
+#define NOMINMAX
+#define PSAPI_VERSION 2 // GetProcessMemoryInfo de kernel32, sin enlazar psapi
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#else
+#include <unistd.h>
+#endif
+
+size_t SoakMonitor::residentBytes() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0;
+    return counters.WorkingSetSize;
+#elif defined(__APPLE__)
+    mach_task_basic_info info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info, &count) != KERN_SUCCESS) return 0;
+    return info.resident_size;
+#else
+    // segundo campo de statm: páginas residentes
+    FILE* f = std::fopen("/proc/self/statm", "r");
+    if (!f) return 0;
+    unsigned long size = 0, resident = 0;
+    int read = std::fscanf(f, "%lu %lu", &size, &resident);
+    std::fclose(f);
+    return read == 2 ? (size_t)resident * (size_t)sysconf(_SC_PAGESIZE) : 0;
+#endif
+}
+
+// Percentiles 50 y 99 y máximo en ms; reordena `v`.
+static void percentiles(std::vector<float>& v, float& p50, float& p99, float& max) {
+    p50 = p99 = max = 0.f;
+    if (v.empty()) return;
+    auto at = [&](double q) {
+        size_t k = std::min(v.size() - 1, (size_t)(q * (v.size() - 1) + 0.5));
+        std::nth_element(v.begin(), v.begin() + k, v.end());
+        return v[k] * 1000.f;
+    };
+    p50 = at(0.50);
+    p99 = at(0.99);
+    max = *std::max_element(v.begin(), v.end()) * 1000.f;
+}
+
+void SoakMonitor::begin(const SoakLimits& l) {
+    limits = l;
+    limits.interval = std::max(0.1f, limits.interval);
+    start = std::chrono::steady_clock::now();
+    nextSample = limits.interval;
+    ticks.clear();
+    frames.clear();
+    samples.clear();
+    samples.reserve((size_t)(limits.duration / limits.interval) + 2);
+    std::printf("%8s %9s %10s %7s %7s %9s %9s %9s %9s %9s %9s\n", "segundos", "RSS MB", "asteroides", "balas",
+                "partidas", "ticks", "tick p50", "tick p99", "tick max", "frame p50", "frame p99");
+}
+
+bool SoakMonitor::poll(const World& world, unsigned games) {
+    const float seconds = std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+    if (seconds < nextSample && seconds < limits.duration) return true;
+    sample(world, games, seconds);
+    nextSample += limits.interval;
+    return seconds < limits.duration;
+}
+
+void SoakMonitor::sample(const World& world, unsigned games, float seconds) {
+    Sample s;
+    s.seconds = seconds;
+    s.rss = residentBytes();
+    s.asteroids = world.asteroids.live();
+    s.bullets = world.bullets.live();
+    s.games = games;
+    s.ticks = ticks.size();
+    percentiles(ticks, s.tickP50, s.tickP99, s.tickMax);
+    percentiles(frames, s.frameP50, s.frameP99, s.frameMax);
+    ticks.clear();
+    frames.clear();
+    samples.push_back(s);
+    std::printf("%8.0f %9.1f %10zu %7zu %7u %9zu %9.4f %9.4f %9.3f %9.3f %9.3f\n", s.seconds, s.rss / 1048576.0,
+                s.asteroids, s.bullets, s.games, s.ticks, s.tickP50, s.tickP99, s.tickMax, s.frameP50, s.frameP99);
+    std::fflush(stdout);
+}
+
+bool SoakMonitor::finish() const {
+    const size_t warmup = std::max<size_t>(1, samples.size() / 10);
+    if (samples.size() < warmup + 3) {
+        std::printf("soak: %zu muestras, hacen falta al menos %zu (duracion / intervalo)\n", samples.size(), warmup + 3);
+        return false;
+    }
+    const size_t n = samples.size() - warmup;
+    const size_t third = std::max<size_t>(1, n / 3);
+    auto minRss = [&](size_t from, size_t count) {
+        size_t m = samples[from].rss;
+        for (size_t i = from; i < from + count; ++i) m = std::min(m, samples[i].rss);
+        return m;
+    };
+    auto medianTick = [&](size_t from, size_t count) {
+        std::vector<float> v;
+        for (size_t i = from; i < from + count; ++i) v.push_back(samples[i].tickP50);
+        std::nth_element(v.begin(), v.begin() + v.size() / 2, v.end());
+        return v[v.size() / 2];
+    };
+    const size_t early = warmup, late = samples.size() - third;
+
+    bool ok = true;
+    const size_t rssBefore = minRss(early, third), rssAfter = minRss(late, third);
+    const double growthMB = ((double)rssAfter - (double)rssBefore) / 1048576.0;
+    if (rssBefore == 0) {
+        std::printf("soak: RSS no disponible en esta plataforma, sin comprobar memoria\n");
+    } else {
+        const bool grew = growthMB > limits.maxRssGrowthMB;
+        std::printf("soak: RSS %.1f MB -> %.1f MB (%+.1f MB, limite %.1f): %s\n", rssBefore / 1048576.0,
+                    rssAfter / 1048576.0, growthMB, limits.maxRssGrowthMB, grew ? "CRECE" : "estable");
+        ok = ok && !grew;
+    }
+    const float tickBefore = medianTick(early, third), tickAfter = medianTick(late, third);
+    const double drift = tickBefore > 0.f ? tickAfter / tickBefore - 1.0 : 0.0;
+    const bool drifted = drift > limits.maxTickDrift;
+    std::printf("soak: tick p50 %.4f ms -> %.4f ms (%+.0f %%, limite %.0f %%): %s\n", tickBefore, tickAfter,
+                drift * 100.0, limits.maxTickDrift * 100.0, drifted ? "DERIVA" : "estable");
+    ok = ok && !drifted;
+    std::printf("soak: %s\n", ok ? "OK" : "FALLA");
+    return ok;
+}
@@ -0,0 +1,73 @@
+#include "SpatialGrid.hpp"
+#include <algorithm>
+#include <cmath>
+
+// módulo siempre positivo, para envolver índices de celda negativos
+static int wrapIndex(int i, int n) {
+    int r = i % n;
+    return r < 0 ? r + n : r;
+}
+
+SpatialGrid::SpatialGrid(float worldWidth, float worldHeight, float cellSize) {
+    // número entero de celdas por eje para que el envolvimiento sea exacto
+    cols = std::max(1, (int)(worldWidth / cellSize));
+    rowCount = std::max(1, (int)(worldHeight / cellSize));
+    cellW = worldWidth / cols;
+    cellH = worldHeight / rowCount;
+    cellStart.assign((size_t)cols*rowCount + 1, 0);
+    cursor.resize((size_t)cols*rowCount);
+}
+
+void SpatialGrid::clear() {
+    pendingCell.clear();
+    pendingId.clear();
+}
+
+void SpatialGrid::cellRange(float lo, float hi, float cellLen, int count, int& first, int& last) const {
+    first = (int)std::floor(lo / cellLen);
+    last = (int)std::floor(hi / cellLen);
+    // un círculo más grande que el mundo cubre todas las celdas una sola vez
+    if (last - first + 1 >= count) { first = 0; last = count - 1; }
+}
+
+template<class F>
+void SpatialGrid::forEachCell(const sf::Vector2f& pos, float radius, F&& fn) const {
+    int x0, x1, y0, y1;
+    cellRange(pos.x - radius, pos.x + radius, cellW, cols, x0, x1);
+    cellRange(pos.y - radius, pos.y + radius, cellH, rowCount, y0, y1);
+    for (int cy = y0; cy <= y1; ++cy) {
+        int row = wrapIndex(cy, rowCount) * cols;
+        for (int cx = x0; cx <= x1; ++cx) fn((std::uint32_t)(row + wrapIndex(cx, cols)));
+    }
+}
+
+void SpatialGrid::insert(std::uint32_t id, const sf::Vector2f& pos, float radius) {
+    forEachCell(pos, radius, [&](std::uint32_t cell) {
+        pendingCell.push_back(cell);
+        pendingId.push_back(id);
+    });
+}
+
+void SpatialGrid::build() {
+    // ordenamiento por conteo: contar por celda, acumular y repartir
+    std::fill(cellStart.begin(), cellStart.end(), 0u);
+    for (std::uint32_t c : pendingCell) cellStart[c + 1]++;
+    for (size_t c = 1; c < cellStart.size(); ++c) cellStart[c] += cellStart[c - 1];
+    entries.resize(pendingId.size());
+    std::copy(cellStart.begin(), cellStart.end() - 1, cursor.begin());
+    for (size_t i = 0; i < pendingId.size(); ++i) entries[cursor[pendingCell[i]]++] = pendingId[i];
+}
+
+void SpatialGrid::query(const sf::Vector2f& pos, float radius, std::vector<std::uint32_t>& out) const {
+    out.clear();
+    int cellsVisited = 0;
+    forEachCell(pos, radius, [&](std::uint32_t cell) {
+        out.insert(out.end(), entries.begin() + cellStart[cell], entries.begin() + cellStart[cell + 1]);
+        cellsVisited++;
+    });
+    // un id puede estar en varias celdas: quitar repetidos y dejar el orden de índice
+    if (cellsVisited > 1) {
+        std::sort(out.begin(), out.end());
+        out.erase(std::unique(out.begin(), out.end()), out.end());
+    }
+}
@@ -0,0 +1,90 @@
+#include "SpriteBatch.hpp"
+#include <cmath>
+
+void SpriteBatch::begin() {
+    for (size_t i = 0; i < used; ++i) batches[i].vertices.clear();
+    used = 0;
+}
+
+sf::VertexArray& SpriteBatch::batchFor(const sf::Texture* texture) {
+    if (used > 0 && batches[used-1].texture == texture) return batches[used-1].vertices;
+    if (used == batches.size()) batches.emplace_back();
+    Batch& b = batches[used++];
+    b.texture = texture;
+    b.vertices.clear();
+    return b.vertices;
+}
+
+void SpriteBatch::addQuad(const sf::Texture* texture, const sf::Vector2f& center, const sf::Vector2f& halfSize,
+                          const sf::FloatRect& uv, const sf::Color& color) {
+    sf::VertexArray& va = batchFor(texture);
+    sf::Vector2f tl(center.x - halfSize.x, center.y - halfSize.y);
+    sf::Vector2f br(center.x + halfSize.x, center.y + halfSize.y);
+    sf::Vector2f uvTl(uv.left, uv.top);
+    sf::Vector2f uvBr(uv.left + uv.width, uv.top + uv.height);
+    // dos triángulos: tl-tr-br y tl-br-bl
+    va.append(sf::Vertex(tl, color, uvTl));
+    va.append(sf::Vertex(sf::Vector2f(br.x, tl.y), color, sf::Vector2f(uvBr.x, uvTl.y)));
+    va.append(sf::Vertex(br, color, uvBr));
+    va.append(sf::Vertex(tl, color, uvTl));
+    va.append(sf::Vertex(br, color, uvBr));
+    va.append(sf::Vertex(sf::Vector2f(tl.x, br.y), color, sf::Vector2f(uvTl.x, uvBr.y)));
+}
+
+void SpriteBatch::addRect(const sf::Vector2f& topLeft, const sf::Vector2f& size, const sf::Color& color) {
+    sf::Vector2f half(size.x/2.f, size.y/2.f);
+    addQuad(nullptr, topLeft + half, half, sf::FloatRect(), color);
+}
+
+void SpriteBatch::addTriangle(const sf::Vector2f& a, const sf::Vector2f& b, const sf::Vector2f& c, const sf::Color& color) {
+    sf::VertexArray& va = batchFor(nullptr);
+    va.append(sf::Vertex(a, color));
+    va.append(sf::Vertex(b, color));
+    va.append(sf::Vertex(c, color));
+}
+
+void SpriteBatch::addCircle(const sf::Vector2f& center, float radius, const sf::Color& color, int segments) {
+    sf::VertexArray& va = batchFor(nullptr);
+    const float step = 2.f * 3.14159f / segments;
+    sf::Vector2f prev(center.x + radius, center.y);
+    for (int i = 1; i <= segments; ++i) {
+        sf::Vector2f next(center.x + std::cos(step*i)*radius, center.y + std::sin(step*i)*radius);
+        va.append(sf::Vertex(center, color));
+        va.append(sf::Vertex(prev, color));
+        va.append(sf::Vertex(next, color));
+        prev = next;
+    }
+}
+
+void SpriteBatch::addRing(const sf::Vector2f& center, float radius, float thickness, const sf::Color& color, int segments) {
+    sf::VertexArray& va = batchFor(nullptr);
+    const float step = 2.f * 3.14159f / segments;
+    const float outer = radius + thickness;
+    for (int i = 0; i < segments; ++i) {
+        float c0 = std::cos(step*i), s0 = std::sin(step*i);
+        float c1 = std::cos(step*(i+1)), s1 = std::sin(step*(i+1));
+        sf::Vector2f in0(center.x + c0*radius, center.y + s0*radius), out0(center.x + c0*outer, center.y + s0*outer);
+        sf::Vector2f in1(center.x + c1*radius, center.y + s1*radius), out1(center.x + c1*outer, center.y + s1*outer);
+        va.append(sf::Vertex(in0, color)); va.append(sf::Vertex(out0, color)); va.append(sf::Vertex(out1, color));
+        va.append(sf::Vertex(in0, color)); va.append(sf::Vertex(out1, color)); va.append(sf::Vertex(in1, color));
+    }
+}
+
+unsigned SpriteBatch::flush(sf::RenderTarget& target, const sf::RenderStates& states) {
+    unsigned calls = 0;
+    for (size_t i = 0; i < used; ++i) {
+        const Batch& b = batches[i];
+        if (b.vertices.getVertexCount() == 0) continue;
+        sf::RenderStates s = states;
+        s.texture = b.texture;
+        target.draw(b.vertices, s);
+        calls++;
+    }
+    return calls;
+}
+
+size_t SpriteBatch::vertexCount() const {
+    size_t n = 0;
+    for (size_t i = 0; i < used; ++i) n += batches[i].vertices.getVertexCount();
+    return n;
+}
@@ -0,0 +1,321 @@
+#include "Ui.hpp"
+#include <algorithm>
+#include <cstdio>
+
+// ---------------------------------------------------------------- etiquetas
+
+void UiLabel::init(const sf::Font* font, unsigned size, const sf::Color& c) {
+    hasFont = font != nullptr;
+    if (hasFont) text.setFont(*font);
+    text.setCharacterSize(size);
+    color = c;
+    text.setFillColor(c);
+}
+
+void UiLabel::place(const sf::Vector2f& pos, bool center) {
+    position = pos;
+    centered = center;
+    relayout();
+}
+
+void UiLabel::setFormat(const std::string& pre, const std::string& suf) {
+    prefix = pre;
+    suffix = suf;
+    hasValue = false;
+}
+
+void UiLabel::setText(const std::string& s) {
+    if (s == current) return;
+    current = s;
+    text.setString(current);
+    relayout();
+}
+
+void UiLabel::setValue(long long v) {
+    if (hasValue && v == value) return;
+    hasValue = true;
+    value = v;
+    setText(prefix + std::to_string(v) + suffix);
+}
+
+void UiLabel::setColor(const sf::Color& c) {
+    if (c == color) return;
+    color = c;
+    text.setFillColor(c);
+}
+
+void UiLabel::relayout() {
+    if (centered) {
+        auto b = text.getLocalBounds();
+        text.setOrigin(b.width/2.f, b.height/2.f);
+    } else {
+        text.setOrigin(0.f, 0.f);
+    }
+    text.setPosition(position);
+}
+
+// ---------------------------------------------------------------- geometría
+
+static const float HEART_SIZE = 20.f;
+static const float BAR_WIDTH = 100.f;
+static const float BAR_HEIGHT = 8.f;
+static const float BUTTON_SIZE = 28.f;
+static const float BUTTON_GAP = 8.f;
+
+// Contorno de `thickness` px por fuera de `r` (como setOutlineThickness).
+static void addOutline(SpriteBatch& b, const sf::FloatRect& r, float t, const sf::Color& c) {
+    b.addRect({r.left - t, r.top - t}, {r.width + 2*t, t}, c);
+    b.addRect({r.left - t, r.top + r.height}, {r.width + 2*t, t}, c);
+    b.addRect({r.left - t, r.top}, {t, r.height}, c);
+    b.addRect({r.left + r.width, r.top}, {t, r.height}, c);
+}
+
+static void addLeftTriangle(SpriteBatch& b, float x, float y, float w, float h, const sf::Color& c) {
+    b.addTriangle({x + w, y}, {x, y + h*0.5f}, {x + w, y + h}, c);
+}
+
+static void addRightTriangle(SpriteBatch& b, float x, float y, float w, float h, const sf::Color& c) {
+    b.addTriangle({x, y}, {x + w, y + h*0.5f}, {x, y + h}, c);
+}
+
+// Corazón simple (abanico desde el centro) para cuando no hay sprite.
+static void addHeartShape(SpriteBatch& b, const sf::Vector2f& center, float s, const sf::Color& c) {
+    const sf::Vector2f pts[6] = {
+        {0.f, -s*0.15f}, {s*0.25f, -s*0.5f}, {s*0.5f, -s*0.15f},
+        {0.f, s*0.5f}, {-s*0.5f, -s*0.15f}, {-s*0.25f, -s*0.5f}
+    };
+    for (int i = 0; i < 6; ++i) b.addTriangle(center, center + pts[i], center + pts[(i+1)%6], c);
+}
+
+// ---------------------------------------------------------------- HUD
+
+void Hud::layout(const sf::Font* font, const SpriteRegion& heartSprite, float w, float h) {
+    width = w;
+    heart = heartSprite;
+
+    score.init(font, 18, sf::Color::White);
+    score.setFormat("Puntos: ");
+    score.place({8.f, 8.f});
+
+    // barra de volumen debajo de los corazones, botones de música debajo de la barra
+    float barX = w - BAR_WIDTH - 8.f;
+    float barY = 8.f + HEART_SIZE + 12.f;
+    volumeBarRect = sf::FloatRect(barX, barY, BAR_WIDTH, BAR_HEIGHT);
+
+    volumeText.init(font, 12, sf::Color::White);
+    volumeText.setFormat("", "%");
+    volumeText.place({barX, barY + BAR_HEIGHT + 2.f});
+
+    float btnY = barY + BAR_HEIGHT + 18.f;
+    float totalW = BUTTON_SIZE*3 + BUTTON_GAP*2;
+    float startX = barX + BAR_WIDTH/2.f - totalW/2.f;
+    prevButtonRect = sf::FloatRect(startX, btnY, BUTTON_SIZE, BUTTON_SIZE);
+    playPauseButtonRect = sf::FloatRect(startX + (BUTTON_SIZE + BUTTON_GAP), btnY, BUTTON_SIZE, BUTTON_SIZE);
+    nextButtonRect = sf::FloatRect(startX + 2*(BUTTON_SIZE + BUTTON_GAP), btnY, BUTTON_SIZE, BUTTON_SIZE);
+
+    debug.init(font, 14, sf::Color::Green);
+    debug.place({8.f, h - 24.f});
+    profile.init(font, 14, sf::Color::Green);
+    profile.place({8.f, 40.f});
+
+    dirty = true;
+}
+
+void Hud::setScore(int s) {
+    score.setValue(s);
+}
+
+void Hud::setLives(int n) {
+    if (n == lives) return;
+    lives = n;
+    dirty = true;
+}
+
+void Hud::setVolume(float v) {
+    if (v == volume) return;
+    volume = v;
+    volumeText.setValue((long long)v);
+    dirty = true;
+}
+
+void Hud::setMusicPlaying(bool playing) {
+    if (playing == musicPlaying) return;
+    musicPlaying = playing;
+    dirty = true;
+}
+
+void Hud::setDebugStats(unsigned drawCalls, size_t vertices, size_t asteroids, size_t bullets, float renderScale) {
+    const unsigned key[5] = {drawCalls, (unsigned)vertices, (unsigned)asteroids, (unsigned)bullets,
+                             (unsigned)(renderScale * 100.f + 0.5f)};
+    if (std::equal(key, key + 5, debugKey)) return;
+    std::copy(key, key + 5, debugKey);
+    char buf[160];
+    std::snprintf(buf, sizeof(buf), "Llamadas de dibujo: %u  Vertices: %u  Asteroides: %u  Balas: %u  Escala: %u%%",
+                  key[0], key[1], key[2], key[3], key[4]);
+    debug.setText(buf);
+}
+
+void Hud::setProfileText(const std::string& text) {
+    profile.setText(text);
+}
+
+HudControl Hud::hitTest(const sf::Vector2f& p) const {
+    if (volumeBarRect.contains(p)) return HudControl::VolumeBar;
+    if (prevButtonRect.contains(p)) return HudControl::PrevTrack;
+    if (playPauseButtonRect.contains(p)) return HudControl::PlayPause;
+    if (nextButtonRect.contains(p)) return HudControl::NextTrack;
+    return HudControl::None;
+}
+
+float Hud::volumeAt(float x) const {
+    float v = (x - volumeBarRect.left) / volumeBarRect.width * 100.f;
+    return std::max(0.f, std::min(100.f, v));
+}
+
+void Hud::rebuildGeometry() {
+    geometry.begin();
+
+    // corazones en la esquina superior derecha (del atlas si hay sprite)
+    for (int i = 0; i < lives; i++) {
+        sf::Vector2f topLeft(width - 8.f - (i+1)*(HEART_SIZE + 6.f), 8.f);
+        sf::Vector2f half(HEART_SIZE/2.f, HEART_SIZE/2.f);
+        if (heart.valid()) geometry.addSprite(heart, topLeft + half, half);
+        else addHeartShape(geometry, topLeft + half + sf::Vector2f(0.f, 4.f), HEART_SIZE, sf::Color::Red);
+    }
+
+    // barra de volumen: fondo, relleno (rojo/amarillo/verde según el volumen) y borde
+    const sf::FloatRect& bar = volumeBarRect;
+    geometry.addRect({bar.left, bar.top}, {bar.width, bar.height}, sf::Color(64, 64, 64));
+    sf::Color fill = volume < 30.f ? sf::Color::Red : (volume < 70.f ? sf::Color::Yellow : sf::Color::Green);
+    geometry.addRect({bar.left, bar.top}, {volume / 100.f * bar.width, bar.height}, fill);
+    addOutline(geometry, bar, 1.f, sf::Color::White);
+
+    // botones de música
+    for (const sf::FloatRect* r : {&prevButtonRect, &playPauseButtonRect, &nextButtonRect}) {
+        geometry.addRect({r->left, r->top}, {r->width, r->height}, sf::Color(40, 40, 40));
+        addOutline(geometry, *r, 1.f, sf::Color::White);
+    }
+
+    const float s = BUTTON_SIZE;
+    float triW = s * 0.45f;
+    float triH = s * 0.7f;
+    float padY = (s - triH) * 0.5f;
+    // anterior: dos triángulos a la izquierda
+    addLeftTriangle(geometry, prevButtonRect.left + s*0.15f, prevButtonRect.top + padY, triW, triH, sf::Color::White);
+    addLeftTriangle(geometry, prevButtonRect.left + s*0.45f, prevButtonRect.top + padY, triW, triH, sf::Color::White);
+    if (musicPlaying) {
+        // pausa: dos barras
+        sf::Vector2f barSize(s*0.18f, s*0.6f);
+        float rx = playPauseButtonRect.left + (s - barSize.x*2 - BUTTON_GAP*0.2f)/2.f;
+        float ry = playPauseButtonRect.top + (s - barSize.y)/2.f;
+        geometry.addRect({rx, ry}, barSize, sf::Color::White);
+        geometry.addRect({rx + barSize.x + BUTTON_GAP*0.1f, ry}, barSize, sf::Color::White);
+    } else {
+        // reproducir: un triángulo a la derecha
+        float pw = s * 0.5f, ph = s * 0.6f;
+        addRightTriangle(geometry, playPauseButtonRect.left + (s - pw)/2.f, playPauseButtonRect.top + (s - ph)/2.f,
+                         pw, ph, sf::Color::White);
+    }
+    // siguiente: dos triángulos a la derecha
+    addRightTriangle(geometry, nextButtonRect.left + s*0.4f, nextButtonRect.top + padY, triW, triH, sf::Color::White);
+    addRightTriangle(geometry, nextButtonRect.left + s*0.1f, nextButtonRect.top + padY, triW, triH, sf::Color::White);
+
+    dirty = false;
+}
+
+unsigned Hud::draw(sf::RenderTarget& target, bool showDebug) {
+    if (dirty) rebuildGeometry();
+    unsigned calls = geometry.flush(target);
+    for (const UiLabel* l : {&score, &volumeText}) {
+        if (!l->visible()) continue;
+        target.draw(l->drawable());
+        calls++;
+    }
+    if (showDebug && debug.visible()) {
+        target.draw(debug.drawable());
+        target.draw(profile.drawable());
+        calls += 2;
+    }
+    return calls;
+}
+
+// ---------------------------------------------------------------- menú
+
+void MenuUi::layout(const sf::Font* font, const std::vector<std::string>& options, float w, float h) {
+    title.init(font, 64, sf::Color::Yellow);
+    title.setText("Asteroides");
+    title.place({w/2.f, h*0.25f}, true);
+
+    items.assign(options.size(), UiLabel());
+    itemRects.assign(options.size(), sf::FloatRect());
+    for (size_t i = 0; i < options.size(); ++i) {
+        items[i].init(font, 32, sf::Color::White);
+        items[i].setText(options[i]);
+        sf::Vector2f pos(w/2.f, h*0.5f + (float)i*48.f);
+        items[i].place(pos, true);
+        // zona del ratón: el texto con un poco de margen, o una caja fija sin fuente
+        if (font) {
+            sf::FloatRect b = items[i].bounds();
+            itemRects[i] = sf::FloatRect(b.left - 8.f, b.top - 4.f, b.width + 16.f, b.height + 8.f);
+        } else {
+            itemRects[i] = sf::FloatRect(pos.x - 110.f, pos.y - 22.f, 220.f, 44.f);
+        }
+    }
+    selection = -1;
+}
+
+void MenuUi::setSelection(int index) {
+    if (index == selection) return;
+    selection = index;
+    for (size_t i = 0; i < items.size(); ++i)
+        items[i].setColor((int)i == selection ? sf::Color::Yellow : sf::Color::White);
+}
+
+int MenuUi::hitTest(const sf::Vector2f& p) const {
+    for (size_t i = 0; i < itemRects.size(); ++i)
+        if (itemRects[i].contains(p)) return (int)i;
+    return -1;
+}
+
+unsigned MenuUi::draw(sf::RenderTarget& target) {
+    if (!title.visible()) return 0;
+    for (const UiLabel& item : items) target.draw(item.drawable());
+    return (unsigned)items.size();
+}
+
+unsigned MenuUi::drawTitle(sf::RenderTarget& target) const {
+    if (!title.visible()) return 0;
+    target.draw(title.drawable());
+    return 1;
+}
+
+// ---------------------------------------------------------------- fin del juego
+
+void GameOverUi::layout(const sf::Font* font, float w, float h) {
+    title.init(font, 48, sf::Color::Red);
+    title.setText("FIN DEL JUEGO");
+    title.place({w/2.f, h/2.f - 80.f}, true);
+
+    finalScore.init(font, 32, sf::Color::Yellow);
+    finalScore.setFormat("Puntuacion Final: ");
+    finalScore.place({w/2.f, h/2.f}, true);
+
+    bestScore.init(font, 32, sf::Color::Cyan);
+    bestScore.setFormat("Mejor Puntuacion: ");
+    bestScore.place({w/2.f, h/2.f + 60.f}, true);
+
+    instructions.init(font, 24, sf::Color::White);
+    instructions.setText("Pulsa R para reiniciar o M para menu");
+    instructions.place({w/2.f, h/2.f + 140.f}, true);
+}
+
+void GameOverUi::setScores(int score, int best) {
+    finalScore.setValue(score);
+    bestScore.setValue(best);
+}
+
+unsigned GameOverUi::draw(sf::RenderTarget& target) {
+    if (!title.visible()) return 0;
+    for (const UiLabel* l : {&title, &finalScore, &bestScore, &instructions}) target.draw(l->drawable());
+    return 4;
+}
@@ -0,0 +1,427 @@
+#include "World.hpp"
+#include "WorldSize.hpp"
+#include "Box2DPhysics.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+
+// Con menos entidades que esto repartir entre hilos cuesta más de lo que ahorra.
+static const size_t PARALLEL_MIN_ENTITIES = 2048;
+// Tamaño de los trozos de trabajo; múltiplo de 8 para los núcleos SIMD.
+static const size_t INTEGRATE_GRAIN = 4096;
+static const size_t COLLISION_GRAIN = 512;
+
+static float length(const sf::Vector2f& v) {
+    return std::sqrt(v.x*v.x + v.y*v.y);
+}
+
+// Celdas de 64 px: cubren el radio máximo de un asteroide grande (48 px)
+World::World(size_t maxAsteroids, size_t maxBullets) : asteroidGrid(WORLD_WIDTH, WORLD_HEIGHT, 64.f) {
+    asteroids.init(maxAsteroids);
+    bullets.init(maxBullets);
+    // cada entidad se da de alta o de baja como mucho una vez por tick
+    asteroidSpawns.reserve(maxAsteroids);
+    bulletSpawns.reserve(maxBullets);
+    asteroidDespawns.reserve(maxAsteroids);
+    bulletDespawns.reserve(maxBullets);
+    explosions.reserve(maxAsteroids + 1);
+    candidates.reserve(64);
+}
+
+void World::seed(std::uint64_t s) {
+    rng.seed(s);
+}
+
+void World::newGame() {
+    score = 0; lives = 3; elapsedTime = 0.f; asteroidTimer = 0.f;
+    resetLevel();
+}
+
+void World::resetLevel() {
+    asteroids.clear(); bullets.clear();
+    asteroidSpawns.clear(); bulletSpawns.clear();
+    asteroidDespawns.clear(); bulletDespawns.clear();
+    player.reset(sf::Vector2f(WORLD_WIDTH/2.f, WORLD_HEIGHT/2.f));
+    player.alive = true;
+    for (Guest& g : guests) g.ship.reset(sf::Vector2f(WORLD_WIDTH/2.f, WORLD_HEIGHT/2.f));
+    spawnAsteroids(6);
+    flushCommands();
+}
+
+void World::queueSpawn(const Asteroid& a) {
+    if (asteroidSpawns.size() < asteroidSpawns.capacity()) asteroidSpawns.push_back(a);
+    else droppedSpawns++;
+}
+
+void World::queueSpawn(const Bullet& b) {
+    if (bulletSpawns.size() < bulletSpawns.capacity()) bulletSpawns.push_back(b);
+    else droppedSpawns++;
+}
+
+void World::flushCommands() {
+    // primero las bajas, para que sus slots queden libres para las altas
+    for (std::uint32_t slot : bulletDespawns) bullets.release(slot);
+    for (std::uint32_t slot : asteroidDespawns) asteroids.release(slot);
+    bulletDespawns.clear();
+    asteroidDespawns.clear();
+    for (const Bullet& b : bulletSpawns) if (bullets.spawn(b) < 0) droppedSpawns++;
+    for (const Asteroid& a : asteroidSpawns) if (asteroids.spawn(a) < 0) droppedSpawns++;
+    bulletSpawns.clear();
+    asteroidSpawns.clear();
+}
+
+void World::step(float dt, const ShipInput& input) {
+    shotsFired = 0;
+    asteroidsDestroyed = 0;
+    explosions.clear();
+
+    if (lives <= 0) return; // fin del juego: esperar reinicio
+
+    // registro de tiempo usado para ajustar la dificultad
+    elapsedTime += dt;
+    timeSinceLastShot += dt;
+    asteroidTimer += dt;
+
+    {
+        ProfileScope zone(profiler, ProfileZone::Input);
+        player.handleInput(input, dt);
+        // disparo (enfriamiento manejado por el temporizador del mundo)
+        if (input.shoot && timeSinceLastShot >= 0.18f) {
+            queueSpawn(player.shoot());
+            timeSinceLastShot = 0.f;
+            shotsFired++;
+        }
+        for (Guest& g : guests) {
+            g.ship.handleInput(g.input, dt);
+            g.timeSinceLastShot += dt;
+            if (g.input.shoot && g.timeSinceLastShot >= 0.18f) {
+                queueSpawn(g.ship.shoot());
+                g.timeSinceLastShot = 0.f;
+                shotsFired++;
+            }
+        }
+    }
+
+    if (physics) {
+        // Box2D integra y busca los contactos; resolveCollisions() solo aplica las reglas
+        ProfileScope zone(profiler, ProfileZone::Integration);
+        bulletDespawns.resize(bullets.live());
+        bulletDespawns.resize(bullets.tickLifetimes(dt, bulletDespawns.data()));
+        physics->step(*this, dt);
+        // las naves invitadas no entran en Box2D
+        for (Guest& g : guests) g.ship.update(dt);
+    } else {
+        ProfileScope zone(profiler, ProfileZone::Integration);
+        player.update(dt);
+        for (Guest& g : guests) g.ship.update(dt);
+        // actualizar balas y asteroides (núcleos SoA); las balas agotadas van directo a la cola de bajas
+        bulletDespawns.resize(bullets.live());
+        bulletDespawns.resize(bullets.tickLifetimes(dt, bulletDespawns.data()));
+        // por rangos de INTEGRATE_GRAIN (múltiplo de 8): el resto escalar queda
+        // al final igual que en un hilo, así el resultado no depende de los hilos
+        const float w = WORLD_WIDTH, h = WORLD_HEIGHT;
+        if (jobs && bullets.slots() >= PARALLEL_MIN_ENTITIES) {
+            jobs->parallelFor(bullets.slots(), INTEGRATE_GRAIN,
+                              [&](size_t b, size_t e, unsigned) { bullets.integrate(dt, w, h, b, e); });
+        } else {
+            bullets.integrate(dt, w, h, 0, bullets.slots());
+        }
+        if (jobs && asteroids.slots() >= PARALLEL_MIN_ENTITIES) {
+            jobs->parallelFor(asteroids.slots(), INTEGRATE_GRAIN,
+                              [&](size_t b, size_t e, unsigned) { asteroids.integrate(dt, w, h, b, e); });
+        } else {
+            asteroids.integrate(dt, w, h, 0, asteroids.slots());
+        }
+    }
+
+    resolveCollisions(dt);
+
+    ProfileScope zone(profiler, ProfileZone::Spawning);
+
+    // generar más asteroides si se han eliminado todos (contando lo encolado)
+    if (asteroids.live() == asteroidDespawns.size() && asteroidSpawns.empty()) {
+        // aumentar la cantidad inicial lentamente con el tiempo
+        unsigned base = 4u;
+        unsigned extra = static_cast<unsigned>(elapsedTime / 20.0f); // +1 cada 20s
+        spawnAsteroids(base + extra);
+    }
+
+    // Generación periódica: conforme avanza el juego, el intervalo entre generados se acorta, aumentando la dificultad.
+    float spawnInterval = std::max(1.0f, 5.0f - elapsedTime / 60.0f); // de 5s hasta mínimo 1s
+    if (asteroidTimer > spawnInterval) {
+        // generar una pequeña cantidad escalada por el tiempo
+        unsigned count = 1 + static_cast<unsigned>(elapsedTime / 60.0f);
+        spawnAsteroids(count);
+        asteroidTimer = 0.f;
+    }
+
+    // único punto del tick donde cambian los pools: bajas y altas encoladas
+    flushCommands();
+}
+
+void World::resolveCollisions(float dt) {
+    ProfileScope zone(profiler, ProfileZone::Collision);
+
+    // colisiones: balas vs asteroides en dos fases.
+    // 1) Los pares (bala, asteroide) que se tocan: los que anotó Box2D en su
+    //    paso o los de la rejilla con choques barridos.
+    size_t chunks = 1;
+    if (physics) {
+        if (hitPairs.empty()) hitPairs.resize(1);
+        hitPairs[0].clear();
+        for (const Box2DPhysics::BulletHit& hit : physics->bulletHits())
+            hitPairs[0].push_back({hit.bullet, hit.asteroid, 0.f});
+    } else {
+        chunks = findBulletHits(dt);
+    }
+
+    // 2) Resolver en orden de bala y de asteroide, en un solo hilo: cada bala
+    //    destruye el primer asteroide que toca (en el tiempo) y que siga vivo.
+    //    Da lo mismo que el bucle de un hilo (puntos, divisiones y aleatoriedad
+    //    en el mismo orden) sin importar cuántos hilos buscaron los pares.
+    for (size_t c=0;c<chunks;++c) {
+        for (const HitPair& hit : hitPairs[c]) {
+            std::uint32_t b = hit.bullet, j = hit.asteroid;
+            if (!bullets.alive[b] || !asteroids.alive[j]) continue;
+            // alive = 0 ya, para que nadie más choque con ellas en este tick
+            bullets.alive[b] = 0;
+            asteroids.alive[j] = 0;
+            bulletDespawns.push_back(b);
+            asteroidDespawns.push_back(j);
+            int size = asteroids.size[j];
+            score += 100 * (size+1);
+            asteroidsDestroyed++;
+            explosions.push_back({sf::Vector2f(asteroids.x[j], asteroids.y[j]),
+                                  sf::Vector2f(asteroids.vx[j], asteroids.vy[j]), asteroids.radius[j], false});
+            // dividir en asteroides más pequeños
+            if (size > 0) {
+                Asteroid parent = asteroids.get(j);
+                for (int i=0;i<2;i++) {
+                    Asteroid child = parent;
+                    child.size = size - 1;
+                    child.radius = parent.radius*0.6f;
+                    float ang = (rng.below(360)) * 3.14159f/180.f;
+                    float speed = 50.f + rng.below(100);
+                    child.velocity = {std::cos(ang)*speed, std::sin(ang)*speed};
+                    child.alive = true;
+                    queueSpawn(child);
+                }
+            }
+        }
+    }
+
+    collideShip(player, dt);
+    for (Guest& g : guests) collideShip(g.ship, dt);
+}
+
+void World::collideShip(Ship& ship, float dt) {
+    if (!ship.alive) return;
+    // barrido también (la nave da la vuelta sin margen). Con Box2D la nave del
+    // jugador usa los contactos de su paso; las invitadas, que no están en
+    // Box2D ni tienen rejilla, prueban todos los asteroides (son pocas naves).
+    const bool contacts = physics && &ship == &player;
+    const Sweep shipSweep = sweepOf(ship.prevPosition, ship.position, ship.velocity, dt);
+    if (contacts) {
+        candidates.assign(physics->shipHits().begin(), physics->shipHits().end());
+    } else if (physics) {
+        candidates.clear();
+        for (size_t j=0;j<asteroids.slots();++j) if (asteroids.alive[j]) candidates.push_back((std::uint32_t)j);
+    } else {
+        asteroidGrid.query(ship.position, ship.radius + length(shipSweep.delta), candidates);
+    }
+    for (std::uint32_t j : candidates) {
+        if (!asteroids.alive[j]) continue;
+        if (!contacts) {
+            const Sweep aSweep = sweepOf(sf::Vector2f(asteroids.prevX[j], asteroids.prevY[j]),
+                                         sf::Vector2f(asteroids.x[j], asteroids.y[j]),
+                                         sf::Vector2f(asteroids.vx[j], asteroids.vy[j]), dt);
+            float toi;
+            if (!sweptCollision(aSweep, asteroids.radius[j], shipSweep, ship.radius, toi)) continue;
+        }
+        destroyShip(ship);
+        return;
+    }
+}
+
+void World::destroyShip(Ship& ship) {
+    ship.alive = false;
+    ship.deaths++;
+    explosions.push_back({ship.position, ship.velocity, ship.radius, true});
+    // Daño: 1 vida hasta 15000 puntos; a partir de 15000, el impacto hace 2 de daño
+    int daño = (score >= 15000) ? 2 : 1;
+
+    lives -= daño;
+    if (lives>0) {
+        ship.reset(sf::Vector2f(WORLD_WIDTH/2.f, WORLD_HEIGHT/2.f));
+        ship.alive = true;
+    } else if (score > maxScore) {
+        maxScore = score;
+    }
+}
+
+size_t World::findBulletHits(float dt) {
+    rebuildAsteroidGrid(dt);
+    // Con choques barridos: una bala rápida o un tick largo no atraviesan un
+    // asteroide sin tocarlo. Cada trozo de balas busca sus pares en paralelo
+    // si hay JobSystem: solo lee y escribe en su propia lista.
+    const size_t bulletCount = bullets.slots();
+    const size_t chunks = (bulletCount + COLLISION_GRAIN - 1) / COLLISION_GRAIN;
+    if (hitPairs.size() < chunks) hitPairs.resize(chunks);
+    const unsigned threads = jobs ? jobs->concurrency() : 1u;
+    if (queryScratch.size() < threads) queryScratch.resize(threads);
+    auto findPairs = [&](size_t begin, size_t end, unsigned slot) {
+        std::vector<HitPair>& pairs = hitPairs[begin / COLLISION_GRAIN];
+        std::vector<std::uint32_t>& found = queryScratch[slot];
+        pairs.clear();
+        for (size_t b=begin;b<end;++b) {
+            if (!bullets.alive[b]) continue;
+            const sf::Vector2f bVel(bullets.vx[b], bullets.vy[b]);
+            const Sweep bSweep = sweepOf(sf::Vector2f(bullets.prevX[b], bullets.prevY[b]),
+                                         sf::Vector2f(bullets.x[b], bullets.y[b]), bVel, dt);
+            const float reach = bullets.radius + length(bSweep.delta);
+            const size_t first = pairs.size();
+            // un asteroide puede salir en las dos consultas: el par repetido no cambia nada
+            for (int side = 0; side < (bSweep.jumped() ? 2 : 1); ++side) {
+                sf::Vector2f at = bSweep.start + bSweep.delta + (side ? sf::Vector2f(0.f, 0.f) : bSweep.jump);
+                asteroidGrid.query(at, reach, found);
+                for (std::uint32_t j : found) {
+                    if (!asteroids.alive[j]) continue;
+                    const Sweep aSweep = sweepOf(sf::Vector2f(asteroids.prevX[j], asteroids.prevY[j]),
+                                                 sf::Vector2f(asteroids.x[j], asteroids.y[j]),
+                                                 sf::Vector2f(asteroids.vx[j], asteroids.vy[j]), dt);
+                    float toi;
+                    if (sweptCollision(aSweep, asteroids.radius[j], bSweep, bullets.radius, toi))
+                        pairs.push_back({(std::uint32_t)b, j, toi});
+                }
+            }
+            // los de esta bala por instante de impacto: se queda con el primero que toca
+            if (pairs.size() - first > 1) std::sort(pairs.begin() + first, pairs.end(), [](const HitPair& l, const HitPair& r) {
+                return l.toi != r.toi ? l.toi < r.toi : l.asteroid < r.asteroid;
+            });
+        }
+    };
+    if (jobs && bulletCount >= PARALLEL_MIN_ENTITIES) jobs->parallelFor(bulletCount, COLLISION_GRAIN, findPairs);
+    else for (size_t b=0;b<bulletCount;b+=COLLISION_GRAIN) findPairs(b, std::min(bulletCount, b + COLLISION_GRAIN), 0);
+    return chunks;
+}
+
+void World::spawnAsteroids(unsigned n) {
+    for (unsigned i=0;i<n;i++) {
+        Asteroid a;
+        // colocar alrededor de los bordes de la pantalla
+        int side = rng.below(4);
+        switch(side) {
+            case 0: a.position = {float(rng.below((std::uint32_t)WORLD_WIDTH)), -20.f}; break;
+            case 1: a.position = {float(rng.below((std::uint32_t)WORLD_WIDTH)), WORLD_HEIGHT+20.f}; break;
+            case 2: a.position = {-20.f, float(rng.below((std::uint32_t)WORLD_HEIGHT))}; break;
+            default: a.position = {WORLD_WIDTH+20.f, float(rng.below((std::uint32_t)WORLD_HEIGHT))}; break;
+        }
+        float ang = (rng.below(360)) * 3.14159f/180.f;
+        // Dificultad: aumentar la velocidad de los asteroides lentamente con el tiempo
+        float difficultyMultiplier = 1.0f + (elapsedTime / 60.0f); // +100% de velocidad por minuto
+        float speed = (30.f + rng.below(80)) * difficultyMultiplier;
+        a.velocity = {std::cos(ang)*speed, std::sin(ang)*speed};
+        a.size = 2;
+        a.radius = 32.f + rng.below(16);
+        a.alive = true;
+        a.prevPosition = a.position;
+        queueSpawn(a);
+    }
+}
+
+void World::rebuildAsteroidGrid(float dt) {
+    asteroidGrid.clear();
+    for (size_t i=0;i<asteroids.slots();++i) {
+        if (!asteroids.alive[i]) continue;
+        const sf::Vector2f pos(asteroids.x[i], asteroids.y[i]);
+        const Sweep sweep = sweepOf(sf::Vector2f(asteroids.prevX[i], asteroids.prevY[i]), pos,
+                                    sf::Vector2f(asteroids.vx[i], asteroids.vy[i]), dt);
+        const float reach = asteroids.radius[i] + length(sweep.delta);
+        asteroidGrid.insert((std::uint32_t)i, pos, reach);
+        if (sweep.jumped()) asteroidGrid.insert((std::uint32_t)i, pos - sweep.jump, reach);
+    }
+    asteroidGrid.build();
+}
+
+World::Sweep World::sweepOf(const sf::Vector2f& prev, const sf::Vector2f& pos, const sf::Vector2f& vel, float dt) {
+    Sweep s;
+    s.start = prev;
+    s.delta = vel * dt;
+    // lo que no explica la velocidad es el salto por el borde; el redondeo deja
+    // restos de milésimas y un salto mide casi un ancho de pantalla
+    const sf::Vector2f rest = pos - (prev + s.delta);
+    s.jump.x = std::fabs(rest.x) > WORLD_WIDTH * 0.5f ? rest.x : 0.f;
+    s.jump.y = std::fabs(rest.y) > WORLD_HEIGHT * 0.5f ? rest.y : 0.f;
+    return s;
+}
+
+// Primera fracción t en [0, 1] con |r0 + t*d| <= radius (r0: posición
+// relativa al empezar, d: desplazamiento relativo en el tick).
+static bool timeOfImpact(const sf::Vector2f& r0, const sf::Vector2f& d, float radius, float& t) {
+    const float c = r0.x*r0.x + r0.y*r0.y - radius*radius;
+    if (c <= 0.f) { t = 0.f; return true; } // ya se tocaban al empezar el tick
+    const float a = d.x*d.x + d.y*d.y;
+    const float halfB = r0.x*d.x + r0.y*d.y;
+    if (a <= 0.f || halfB >= 0.f) return false; // quietos entre sí o alejándose
+    const float disc = halfB*halfB - a*c;
+    if (disc < 0.f) return false;
+    t = (-halfB - std::sqrt(disc)) / a;
+    return t <= 1.f;
+}
+
+bool World::sweptCollision(const Sweep& a, float aR, const Sweep& b, float bR, float& toi) {
+    // el movimiento relativo es una recta; si alguno saltó por el borde, su
+    // trayecto de después es el mismo desplazado por el salto
+    const sf::Vector2f r0 = b.start - a.start, d = b.delta - a.delta;
+    bool hit = false;
+    for (int k = 0; k < 4; ++k) {
+        if (((k & 1) && !a.jumped()) || ((k & 2) && !b.jumped())) continue;
+        sf::Vector2f r = r0;
+        if (k & 1) r -= a.jump;
+        if (k & 2) r += b.jump;
+        float t;
+        if (timeOfImpact(r, d, aR + bR, t) && (!hit || t < toi)) {
+            toi = t;
+            hit = true;
+        }
+    }
+    return hit;
+}
+
+// FNV-1a sobre los bytes de cada valor
+static void hashBytes(std::uint64_t& h, const void* data, size_t n) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < n; ++i) {
+        h ^= p[i];
+        h *= 0x100000001B3ull;
+    }
+}
+
+template <typename T>
+static void hashValue(std::uint64_t& h, const T& v) {
+    hashBytes(h, &v, sizeof(v));
+}
+
+std::uint64_t World::checksum() const {
+    std::uint64_t h = 0xCBF29CE484222325ull;
+    hashValue(h, score);
+    hashValue(h, lives);
+    hashValue(h, elapsedTime);
+    hashValue(h, player.position.x); hashValue(h, player.position.y);
+    hashValue(h, player.velocity.x); hashValue(h, player.velocity.y);
+    hashValue(h, player.angle);
+    for (size_t i = 0; i < asteroids.slots(); ++i) {
+        if (!asteroids.alive[i]) continue;
+        hashValue(h, asteroids.x[i]); hashValue(h, asteroids.y[i]);
+        hashValue(h, asteroids.radius[i]);
+    }
+    for (size_t i = 0; i < bullets.slots(); ++i) {
+        if (!bullets.alive[i]) continue;
+        hashValue(h, bullets.x[i]); hashValue(h, bullets.y[i]);
+    }
+    for (const Guest& g : guests) {
+        hashValue(h, g.ship.position.x); hashValue(h, g.ship.position.y);
+        hashValue(h, g.ship.angle);
+    }
+    return h;
+}
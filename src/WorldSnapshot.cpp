@@ -0,0 +1,18 @@
+#include "WorldSnapshot.hpp"
+#include "World.hpp"
+
+void WorldSnapshot::capture(const World& world) {
+    asteroids.clear();
+    for (size_t i=0;i<world.asteroids.slots();++i)
+        if (world.asteroids.alive[i]) asteroids.push_back(world.asteroids.get(i));
+    bullets.clear();
+    for (size_t i=0;i<world.bullets.slots();++i)
+        if (world.bullets.alive[i]) bullets.push_back(world.bullets.get(i));
+    player = world.player;
+    guests.clear();
+    for (const World::Guest& g : world.guests) guests.push_back(g.ship);
+    score = world.score;
+    maxScore = world.maxScore;
+    lives = world.lives;
+    gameOver = world.isGameOver();
+}
@@ -0,0 +1,228 @@
+#include "WorldState.hpp"
+#include "World.hpp"
+#include "Replay.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+static const char STATE_MAGIC[4] = {'A','S','T','S'};
+static const std::uint32_t STATE_VERSION = 2;
+// Las columnas de los pools ocupan slots() redondeado a este múltiplo: así su
+// desplazamiento no cambia cada vez que el pool crece o se vacía.
+static const size_t SLOT_CHUNK = 16;
+
+// magia, versión, slots y ancho de columna de cada pool, invitados
+static const size_t HEADER_BYTES = 4 + 4 + 4*4 + 1;
+// puntos, récord, vidas, tres temporizadores, altas descartadas y el Rng
+static const size_t SCALAR_BYTES = 3*4 + 3*4 + 4 + 4*4;
+// 10 flotantes y tres bytes (viva, empujando, muertes)
+static const size_t SHIP_BYTES = 10*4 + 3;
+// id, entrada y su temporizador de disparo
+static const size_t GUEST_BYTES = 2 + 4 + SHIP_BYTES;
+// por slot: 7 columnas de flotantes y tamaño, viva y generación / 7 flotantes, viva y generación
+static const size_t ASTEROID_BYTES = 7*4 + 3;
+static const size_t BULLET_BYTES = 7*4 + 2;
+
+static size_t stateSize(size_t asteroidStride, size_t bulletStride, size_t guests) {
+    return HEADER_BYTES + SCALAR_BYTES + SHIP_BYTES + guests * GUEST_BYTES
+         + asteroidStride * ASTEROID_BYTES + bulletStride * BULLET_BYTES;
+}
+
+// Ancho de las columnas de un pool con `slots` slots en uso.
+static size_t columnStride(size_t slots, size_t capacity) {
+    // un pool vacío conserva su primer bloque: vaciarse tampoco mueve lo que sigue
+    return std::min(capacity, std::max<size_t>(1, (slots + SLOT_CHUNK - 1) / SLOT_CHUNK) * SLOT_CHUNK);
+}
+
+// Escritura y lectura sobre un búfer ya dimensionado (el tamaño se comprueba antes).
+struct StateWriter {
+    std::uint8_t* p;
+    void u8(std::uint32_t v) { *p++ = (std::uint8_t)v; }
+    void u32(std::uint32_t v) { for (int i = 0; i < 4; ++i) *p++ = (std::uint8_t)(v >> (8*i)); }
+    void f32(float v) { std::uint32_t bits; std::memcpy(&bits, &v, 4); u32(bits); }
+    // columna de flotantes por planos de bytes; de n a stride van ceros
+    void floats(const float* v, size_t n, size_t stride) {
+        for (int plane = 0; plane < 4; ++plane) {
+            for (size_t i = 0; i < n; ++i) {
+                std::uint32_t bits;
+                std::memcpy(&bits, &v[i], 4);
+                *p++ = (std::uint8_t)(bits >> (8*plane));
+            }
+            zeros(stride - n);
+        }
+    }
+    void bytes(const void* v, size_t n) { std::memcpy(p, v, n); p += n; }
+    void bytes(const void* v, size_t n, size_t stride) { bytes(v, n); zeros(stride - n); }
+    void zeros(size_t n) { std::memset(p, 0, n); p += n; }
+};
+
+struct StateReader {
+    const std::uint8_t* p;
+    std::uint32_t u8() { return *p++; }
+    std::uint32_t u32() { std::uint32_t v = 0; for (int i = 0; i < 4; ++i) v |= (std::uint32_t)*p++ << (8*i); return v; }
+    float f32() { std::uint32_t bits = u32(); float v; std::memcpy(&v, &bits, 4); return v; }
+    void floats(float* v, size_t n, size_t stride) {
+        for (size_t i = 0; i < n; ++i) {
+            std::uint32_t bits = 0;
+            for (int plane = 0; plane < 4; ++plane) bits |= (std::uint32_t)p[plane*stride + i] << (8*plane);
+            std::memcpy(&v[i], &bits, 4);
+        }
+        p += 4*stride;
+    }
+    void bytes(void* v, size_t n) { std::memcpy(v, p, n); p += n; }
+    void bytes(void* v, size_t n, size_t stride) { std::memcpy(v, p, n); p += stride; }
+};
+
+static void writeShip(StateWriter& w, const Ship& s, float timeSinceShot) {
+    w.f32(s.position.x); w.f32(s.position.y);
+    w.f32(s.velocity.x); w.f32(s.velocity.y);
+    w.f32(s.angle);
+    w.f32(s.prevPosition.x); w.f32(s.prevPosition.y);
+    w.f32(s.prevAngle);
+    w.f32(s.radius);
+    w.f32(timeSinceShot);
+    w.u8(s.alive ? 1 : 0);
+    w.u8(s.thrusting ? 1 : 0);
+    w.u8(s.deaths);
+}
+
+static void readShip(StateReader& r, Ship& s, float& timeSinceShot) {
+    s.position.x = r.f32(); s.position.y = r.f32();
+    s.velocity.x = r.f32(); s.velocity.y = r.f32();
+    s.angle = r.f32();
+    s.prevPosition.x = r.f32(); s.prevPosition.y = r.f32();
+    s.prevAngle = r.f32();
+    s.radius = r.f32();
+    timeSinceShot = r.f32();
+    s.alive = r.u8() != 0;
+    s.thrusting = r.u8() != 0;
+    s.deaths = (std::uint8_t)r.u8();
+}
+
+void WorldState::capture(const World& world) {
+    const AsteroidStore& as = world.asteroids;
+    const BulletStore& bs = world.bullets;
+    const size_t na = as.slots(), nb = bs.slots();
+    const size_t sa = columnStride(na, as.capacity()), sb = columnStride(nb, bs.capacity());
+    bytes.resize(stateSize(sa, sb, world.guests.size()));
+    StateWriter w{bytes.data()};
+
+    w.bytes(STATE_MAGIC, 4);
+    w.u32(STATE_VERSION);
+    w.u32((std::uint32_t)na);
+    w.u32((std::uint32_t)sa);
+    w.u32((std::uint32_t)nb);
+    w.u32((std::uint32_t)sb);
+    w.u8((std::uint32_t)world.guests.size());
+
+    w.u32((std::uint32_t)world.score);
+    w.u32((std::uint32_t)world.maxScore);
+    w.u32((std::uint32_t)world.lives);
+    w.f32(world.timeSinceLastShot);
+    w.f32(world.asteroidTimer);
+    w.f32(world.elapsedTime);
+    w.u32(world.droppedSpawns);
+    std::uint32_t rng[4];
+    world.rng.getState(rng);
+    for (std::uint32_t v : rng) w.u32(v);
+
+    writeShip(w, world.player, world.player.timeSinceShot);
+    for (const World::Guest& g : world.guests) {
+        w.u8(g.id);
+        w.u8(Replay::packInput(g.input));
+        w.f32(g.timeSinceLastShot);
+        writeShip(w, g.ship, g.ship.timeSinceShot);
+    }
+
+    w.floats(as.x.data(), na, sa); w.floats(as.y.data(), na, sa);
+    w.floats(as.prevX.data(), na, sa); w.floats(as.prevY.data(), na, sa);
+    w.floats(as.vx.data(), na, sa); w.floats(as.vy.data(), na, sa);
+    w.floats(as.radius.data(), na, sa);
+    w.bytes(as.size.data(), na, sa);
+    w.bytes(as.alive.data(), na, sa);
+    w.bytes(as.generation.data(), na, sa);
+
+    w.floats(bs.x.data(), nb, sb); w.floats(bs.y.data(), nb, sb);
+    w.floats(bs.prevX.data(), nb, sb); w.floats(bs.prevY.data(), nb, sb);
+    w.floats(bs.vx.data(), nb, sb); w.floats(bs.vy.data(), nb, sb);
+    w.floats(bs.lifetime.data(), nb, sb);
+    w.bytes(bs.alive.data(), nb, sb);
+    w.bytes(bs.generation.data(), nb, sb);
+}
+
+bool WorldState::restore(World& world) const {
+    // todo se comprueba antes de escribir: el tamaño depende solo de la cabecera
+    if (bytes.size() < HEADER_BYTES || std::memcmp(bytes.data(), STATE_MAGIC, 4) != 0) return false;
+    StateReader r{bytes.data() + 4};
+    if (r.u32() != STATE_VERSION) return false;
+    const size_t na = r.u32(), sa = r.u32(), nb = r.u32(), sb = r.u32(), guests = r.u8();
+    if (na > world.asteroids.capacity() || nb > world.bullets.capacity() || na > sa || nb > sb) return false;
+    if (bytes.size() != stateSize(sa, sb, guests)) return false;
+
+    world.score = (int)r.u32();
+    world.maxScore = (int)r.u32();
+    world.lives = (int)r.u32();
+    world.timeSinceLastShot = r.f32();
+    world.asteroidTimer = r.f32();
+    world.elapsedTime = r.f32();
+    world.droppedSpawns = r.u32();
+    std::uint32_t rng[4];
+    for (std::uint32_t& v : rng) v = r.u32();
+    world.rng.setState(rng);
+
+    readShip(r, world.player, world.player.timeSinceShot);
+    world.guests.resize(guests);
+    for (World::Guest& g : world.guests) {
+        g.id = (std::uint8_t)r.u8();
+        g.input = Replay::unpackInput((std::uint8_t)r.u8());
+        g.timeSinceLastShot = r.f32();
+        g.ship.sprite = world.player.sprite;
+        readShip(r, g.ship, g.ship.timeSinceShot);
+    }
+
+    AsteroidStore& as = world.asteroids;
+    r.floats(as.x.data(), na, sa); r.floats(as.y.data(), na, sa);
+    r.floats(as.prevX.data(), na, sa); r.floats(as.prevY.data(), na, sa);
+    r.floats(as.vx.data(), na, sa); r.floats(as.vy.data(), na, sa);
+    r.floats(as.radius.data(), na, sa);
+    r.bytes(as.size.data(), na, sa);
+    r.bytes(as.alive.data(), na, sa);
+    r.bytes(as.generation.data(), na, sa);
+    as.resetSlots(na);
+
+    BulletStore& bs = world.bullets;
+    r.floats(bs.x.data(), nb, sb); r.floats(bs.y.data(), nb, sb);
+    r.floats(bs.prevX.data(), nb, sb); r.floats(bs.prevY.data(), nb, sb);
+    r.floats(bs.vx.data(), nb, sb); r.floats(bs.vy.data(), nb, sb);
+    r.floats(bs.lifetime.data(), nb, sb);
+    r.bytes(bs.alive.data(), nb, sb);
+    r.bytes(bs.generation.data(), nb, sb);
+    bs.resetSlots(nb);
+
+    world.asteroidSpawns.clear(); world.bulletSpawns.clear();
+    world.asteroidDespawns.clear(); world.bulletDespawns.clear();
+    world.shotsFired = 0;
+    world.asteroidsDestroyed = 0;
+    world.explosions.clear();
+    return true;
+}
+
+bool WorldState::save(const std::string& path) const {
+    FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) return false;
+    bool ok = std::fwrite(bytes.data(), 1, bytes.size(), f) == bytes.size();
+    return std::fclose(f) == 0 && ok;
+}
+
+bool WorldState::load(const std::string& path) {
+    FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f) return false;
+    std::vector<std::uint8_t> in;
+    std::uint8_t buf[4096];
+    size_t n;
+    while ((n = std::fread(buf, 1, sizeof(buf), f)) > 0) in.insert(in.end(), buf, buf + n);
+    std::fclose(f);
+    if (in.size() < HEADER_BYTES || std::memcmp(in.data(), STATE_MAGIC, 4) != 0) return false;
+    bytes.swap(in);
+    return true;
+}
@@ -1,7 +1,69 @@
 #include "Game.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <string>
 
-int main() {
+// Opciones: --tick-rate HZ  --max-steps N  --fps N (0 = vsync)
+//           --profile-out ARCHIVO (.json para chrome://tracing, si no CSV)
+//           --record ARCHIVO  --replay ARCHIVO  --replay-speed X
+//           --session ARCHIVO (partida guardada con F5 y cargada con F9)
+//           --autopilot 1 (la nave juega sola)
+//           --soak SEGUNDOS [--soak-interval S] [--soak-max-rss MB] [--soak-max-drift PCT]
+//                     (prueba de resistencia con el piloto automático; sale con 2 si falla)
+//           --threads N (hilos de trabajo además del principal, 0 = según los núcleos)
+//           --render-thread 1 (dibujar en un hilo aparte)
+//           --fullscreen 1  --dynamic-res FPS (escala de la escena para mantener FPS)
+//           --physics propio|box2d (motor de física Box2D en lugar del propio)
+//           --host PUERTO [--snapshot-rate HZ] | --connect HOST:PUERTO (partida en red por UDP)
+int main(int argc, char** argv) {
     Game game;
+    int hostPort = -1;
+    float snapshotRate = 20.f;
+    std::string connectTo;
+    SoakLimits soak;
+    bool soakRequested = false;
+    for (int i=1;i+1<argc;i+=2) {
+        std::string arg = argv[i];
+        if (arg == "--host") { hostPort = std::atoi(argv[i+1]); continue; }
+        if (arg == "--snapshot-rate") { snapshotRate = std::strtof(argv[i+1], nullptr); continue; }
+        if (arg == "--connect") { connectTo = argv[i+1]; continue; }
+        if (arg == "--tick-rate") game.setTickRate(std::strtof(argv[i+1], nullptr));
+        else if (arg == "--max-steps") game.setMaxCatchUpSteps(std::atoi(argv[i+1]));
+        else if (arg == "--fps") game.setFrameLimit((unsigned)std::atoi(argv[i+1]));
+        else if (arg == "--profile-out") game.setProfileOutput(argv[i+1]);
+        else if (arg == "--record") game.setRecordOutput(argv[i+1]);
+        else if (arg == "--session") game.setSessionFile(argv[i+1]);
+        else if (arg == "--autopilot") game.setAutopilot(std::atoi(argv[i+1]) != 0);
+        else if (arg == "--soak") { soak.duration = std::strtof(argv[i+1], nullptr); soakRequested = true; }
+        else if (arg == "--soak-interval") soak.interval = std::strtof(argv[i+1], nullptr);
+        else if (arg == "--soak-max-rss") soak.maxRssGrowthMB = std::strtod(argv[i+1], nullptr);
+        else if (arg == "--soak-max-drift") soak.maxTickDrift = std::strtod(argv[i+1], nullptr) / 100.0;
+        else if (arg == "--threads") game.setWorkerThreads((unsigned)std::atoi(argv[i+1]));
+        else if (arg == "--fullscreen") game.setFullscreen(std::atoi(argv[i+1]) != 0);
+        else if (arg == "--dynamic-res") game.setDynamicResolution(std::strtof(argv[i+1], nullptr));
+        else if (arg == "--render-thread") game.setRenderThread(std::atoi(argv[i+1]) != 0);
+        else if (arg == "--replay-speed") game.setReplaySpeed(std::strtof(argv[i+1], nullptr));
+        else if (arg == "--physics" && std::string(argv[i+1]) != "propio" && std::string(argv[i+1]) != "box2d") {
+            std::fprintf(stderr, "motor de fisica desconocido: %s (propio|box2d)\n", argv[i+1]);
+            return 1;
+        } else if (arg == "--physics" && !game.setBox2DPhysics(std::string(argv[i+1]) == "box2d")) {
+            std::fprintf(stderr, "compilado sin Box2D (make BOX2D=1)\n");
+            return 1;
+        } else if (arg == "--replay" && !game.loadReplay(argv[i+1])) {
+            std::fprintf(stderr, "no se pudo leer la repeticion %s\n", argv[i+1]);
+            return 1;
+        }
+    }
+    if (soakRequested) game.setSoak(soak);
+    // la red se abre al final: usa la frecuencia de ticks ya elegida
+    if (hostPort >= 0 && !game.hostGame((unsigned short)hostPort, snapshotRate)) return 1;
+    if (!connectTo.empty()) {
+        size_t colon = connectTo.rfind(':');
+        if (colon == std::string::npos || !game.joinGame(connectTo.substr(0, colon), (unsigned short)std::atoi(connectTo.c_str() + colon + 1))) {
+            std::fprintf(stderr, "no se pudo conectar a %s (HOST:PUERTO)\n", connectTo.c_str());
+            return 1;
+        }
+    }
     game.run();
-    return 0;
+    return game.soakPassed() ? 0 : 2;
 }
@@ -0,0 +1,6 @@
+#pragma once
+
+// Cuenta las asignaciones del montón (operator new) de todo el programa, para
+// comprobar que el tick de la simulación no pide memoria. Solo se enlaza en
+// las herramientas (headless, bench), nunca en el juego.
+unsigned long allocationCount();
@@ -0,0 +1,217 @@
+// Benchmarks de la simulación con escenarios guionizados, sin ventana. Imprime
+// un JSON con ticks/s, ns por entidad y asignaciones por tick de cada escenario
+// para comparar entre versiones (make bench).
+//
+// Uso: AsteroidsBench.exe [--scenario NOMBRE]... [--seed N] [--threads N] [--out ARCHIVO]
+//                         [--physics propio|box2d|ambos]
+//      AsteroidsBench.exe --list
+//
+// Con --physics ambos cada escenario corre con el motor propio y con Box2D
+// para comparar el costo por tick.
+#include "World.hpp"
+#include "WorldSize.hpp"
+#include "SimdKernels.hpp"
+#include "Box2DPhysics.hpp"
+#include "alloc_counter.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#ifndef ASTEROIDS_VERSION
+#define ASTEROIDS_VERSION "desconocida"
+#endif
+
+static const float DT = 1.f/60.f;
+static const float PI = 3.14159f;
+
+// Aleatoriedad de la preparación de los escenarios (la del mundo va aparte)
+static Rng setupRng;
+
+static float randomRange(float lo, float hi) {
+    return setupRng.uniform(lo, hi);
+}
+
+static Asteroid randomAsteroid(float speed) {
+    Asteroid a;
+    a.position = {randomRange(0.f, WORLD_WIDTH), randomRange(0.f, WORLD_HEIGHT)};
+    a.prevPosition = a.position;
+    float ang = randomRange(0.f, 2*PI);
+    a.velocity = {std::cos(ang)*speed, std::sin(ang)*speed};
+    a.size = 2;
+    a.radius = 32.f + setupRng.below(16);
+    return a;
+}
+
+static Bullet randomBullet(float lifetime) {
+    Bullet b;
+    b.position = {randomRange(0.f, WORLD_WIDTH), randomRange(0.f, WORLD_HEIGHT)};
+    b.prevPosition = b.position;
+    float ang = randomRange(0.f, 2*PI);
+    b.velocity = {std::cos(ang)*500.f, std::sin(ang)*500.f};
+    b.lifetime = lifetime;
+    return b;
+}
+
+// La nave gira y dispara sin parar; sin límite de vidas para que el escenario
+// dure los ticks pedidos.
+static ShipInput benchInput(unsigned long tick) {
+    ShipInput in;
+    in.right = true;
+    in.shoot = true;
+    in.thrust = (tick % 120) < 10;
+    return in;
+}
+
+struct Scenario {
+    const char* name;
+    const char* description;
+    size_t maxAsteroids, maxBullets;
+    unsigned long ticks;
+    void (*setup)(World&);
+};
+
+static void setupSplit(World& w) {
+    // 10k asteroides grandes y 8k balas repartidos por la pantalla: muchas
+    // divisiones en los primeros ticks
+    w.asteroids.clear();
+    for (int i=0;i<10000;i++) w.asteroids.spawn(randomAsteroid(randomRange(30.f, 110.f)));
+    for (int i=0;i<8000;i++) w.bullets.spawn(randomBullet(2.f));
+}
+
+static void setupBullets(World& w) {
+    // 50k balas que no caducan durante el escenario, con los asteroides iniciales
+    for (int i=0;i<50000;i++) w.bullets.spawn(randomBullet(1e6f));
+}
+
+static void setupLateGame(World& w) {
+    // a los 10 minutos: una tanda de 11 asteroides por segundo, 11 veces más rápidos
+    w.elapsedTime = 600.f;
+}
+
+static const Scenario SCENARIOS[] = {
+    {"split-10k", "10k asteroides grandes partiéndose bajo 8k balas", 65536, 16384, 300, setupSplit},
+    {"bullets-50k", "50k balas en vuelo", 4096, 65536, 600, setupBullets},
+    {"late-game", "curva de generación desde elapsedTime = 600 s", 16384, 1024, 3600, setupLateGame},
+};
+
+struct Result {
+    unsigned long ticks = 0;
+    double seconds = 0.0;
+    unsigned long long entitySum = 0;
+    size_t peakEntities = 0;
+    unsigned long allocations = 0;
+    unsigned dropped = 0;
+    std::uint64_t checksum = 0;
+};
+
+static Result runScenario(const Scenario& sc, unsigned seed, JobSystem* jobs, bool box2d) {
+    // el mundo se crea antes de medir: sus pools son la única memoria grande
+    std::unique_ptr<World> world(new World(sc.maxAsteroids, sc.maxBullets));
+    std::unique_ptr<Box2DPhysics> physics;
+    if (box2d) physics = std::make_unique<Box2DPhysics>();
+    world->jobs = jobs;
+    world->physics = physics.get();
+    world->seed(seed);
+    world->newGame();
+    world->lives = 1 << 30;
+    sc.setup(*world);
+
+    Result r;
+    unsigned long allocBefore = allocationCount();
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned long t=0; t<sc.ticks; t++) {
+        world->step(DT, benchInput(t));
+        size_t n = world->asteroids.live() + world->bullets.live();
+        r.entitySum += n;
+        if (n > r.peakEntities) r.peakEntities = n;
+    }
+    r.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    r.allocations = allocationCount() - allocBefore;
+    r.ticks = sc.ticks;
+    r.dropped = world->droppedSpawns;
+    r.checksum = world->checksum();
+    return r;
+}
+
+int main(int argc, char** argv) {
+    std::vector<std::string> selected;
+    unsigned seed = 1;
+    std::string outPath;
+    int threads = -1; // sin JobSystem: un solo hilo
+    std::string physicsMode = "propio";
+    for (int i=1;i<argc;i++) {
+        std::string arg = argv[i];
+        bool hasValue = i+1 < argc;
+        if (arg == "--scenario" && hasValue) selected.push_back(argv[++i]);
+        else if (arg == "--seed" && hasValue) seed = (unsigned)std::strtoul(argv[++i], nullptr, 10);
+        else if (arg == "--out" && hasValue) outPath = argv[++i];
+        else if (arg == "--threads" && hasValue) threads = std::atoi(argv[++i]);
+        else if (arg == "--physics" && hasValue) physicsMode = argv[++i];
+        else if (arg == "--list") {
+            for (const Scenario& sc : SCENARIOS) std::printf("%-12s %s\n", sc.name, sc.description);
+            return 0;
+        } else {
+            std::fprintf(stderr, "uso: %s [--scenario NOMBRE]... [--seed N] [--threads N] [--out ARCHIVO] [--physics propio|box2d|ambos] | --list\n", argv[0]);
+            return 1;
+        }
+    }
+    if (physicsMode != "propio" && physicsMode != "box2d" && physicsMode != "ambos") {
+        std::fprintf(stderr, "motor de fisica desconocido: %s\n", physicsMode.c_str());
+        return 1;
+    }
+    if (physicsMode != "propio" && !Box2DPhysics::available()) {
+        std::fprintf(stderr, "compilado sin Box2D (make BOX2D=1)\n");
+        return 1;
+    }
+    std::vector<bool> engines; // false = propio, true = Box2D
+    if (physicsMode != "box2d") engines.push_back(false);
+    if (physicsMode != "propio") engines.push_back(true);
+    for (const std::string& name : selected) {
+        bool known = false;
+        for (const Scenario& sc : SCENARIOS) known = known || name == sc.name;
+        if (!known) {
+            std::fprintf(stderr, "escenario desconocido: %s (ver --list)\n", name.c_str());
+            return 1;
+        }
+    }
+
+    std::unique_ptr<JobSystem> jobs;
+    if (threads >= 0) jobs.reset(new JobSystem((unsigned)threads));
+
+    FILE* out = outPath.empty() ? stdout : std::fopen(outPath.c_str(), "w");
+    if (!out) {
+        std::fprintf(stderr, "no se pudo abrir %s\n", outPath.c_str());
+        return 1;
+    }
+
+    std::fprintf(out, "{\n  \"version\": \"%s\",\n  \"simd\": \"%s\",\n  \"seed\": %u,\n  \"threads\": %u,\n  \"dt\": %.6f,\n  \"scenarios\": [",
+                 ASTEROIDS_VERSION, simdPathName(), seed, jobs ? jobs->concurrency() : 1u, DT);
+    bool first = true;
+    for (const Scenario& sc : SCENARIOS) {
+        bool run = selected.empty();
+        for (const std::string& name : selected) run = run || name == sc.name;
+        if (!run) continue;
+
+        for (bool box2d : engines) {
+            // cada escenario arranca con la misma semilla: resultados comparables aunque se filtre
+            setupRng.seed(seed);
+            Result r = runScenario(sc, seed, jobs.get(), box2d);
+            double ticksPerSec = r.seconds > 0.0 ? r.ticks / r.seconds : 0.0;
+            double nsPerEntity = r.entitySum ? r.seconds * 1e9 / (double)r.entitySum : 0.0;
+            std::fprintf(out, "%s\n    {\"name\": \"%s\", \"physics\": \"%s\", \"ticks\": %lu, \"seconds\": %.6f, \"ticks_per_sec\": %.1f, "
+                              "\"entities_avg\": %.1f, \"entities_peak\": %zu, \"ns_per_entity\": %.3f, "
+                              "\"allocs_per_tick\": %.4f, \"dropped_spawns\": %u, \"checksum\": \"%016llx\"}",
+                         first ? "" : ",", sc.name, box2d ? "box2d" : "propio", r.ticks, r.seconds, ticksPerSec,
+                         r.ticks ? (double)r.entitySum / r.ticks : 0.0, r.peakEntities, nsPerEntity,
+                         r.ticks ? (double)r.allocations / r.ticks : 0.0, r.dropped, (unsigned long long)r.checksum);
+            first = false;
+        }
+    }
+    std::fprintf(out, "\n  ]\n}\n");
+    if (out != stdout) std::fclose(out);
+    return 0;
+}
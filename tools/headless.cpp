@@ -0,0 +1,522 @@
+// Modo headless: avanza `World` sin ventana, audio ni archivos y mide cuántos
+// ticks por segundo se simulan. Pensado para CI y para correr muchas partidas
+// seguidas sin pantalla.
+//
+// Uso: AsteroidsHeadless.exe [--ticks N] [--games N] [--dt S] [--seed N] [--profile ARCHIVO]
+//                            [--record ARCHIVO] [--replay ARCHIVO] [--threads N] [--physics propio|box2d] [--autopilot]
+//      AsteroidsHeadless.exe --soak SEGUNDOS [--soak-interval S] [--soak-max-rss MB] [--soak-max-drift PCT]
+//                            (el piloto automático juega sin parar; falla si crece la memoria o el tick)
+//      AsteroidsHeadless.exe --serve PUERTO [--clients N] [--snapshot-rate HZ] [--asteroids N] [--ticks N]
+//      AsteroidsHeadless.exe --connect HOST:PUERTO [--ticks N]
+//                            (partida en red en tiempo real; al final, los contadores de cada conexión)
+//      AsteroidsHeadless.exe --grid-bench   (rejilla espacial vs fuerza bruta)
+//      AsteroidsHeadless.exe --kernel-bench (núcleos SoA con 100k entidades)
+//      AsteroidsHeadless.exe --batch-check  (llamadas de dibujo por frame)
+//      AsteroidsHeadless.exe --particle-bench (50k partículas: update y vértices)
+//      AsteroidsHeadless.exe --rewind-check (rebobinar y guardar/cargar dan la misma partida)
+#include "World.hpp"
+#include "WorldSize.hpp"
+#include "SpatialGrid.hpp"
+#include "SimdKernels.hpp"
+#include "SpriteBatch.hpp"
+#include "Profiler.hpp"
+#include "Replay.hpp"
+#include "Particles.hpp"
+#include "Box2DPhysics.hpp"
+#include "NetServer.hpp"
+#include "NetClient.hpp"
+#include "WorldState.hpp"
+#include "RewindBuffer.hpp"
+#include "Autopilot.hpp"
+#include "SoakMonitor.hpp"
+#include "alloc_counter.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+
+// Entrada guionizada: la nave gira y dispara sin parar, con empujes cortos,
+// suficiente para destruir asteroides y terminar partidas.
+static ShipInput scriptedInput(unsigned long tick) {
+    ShipInput in;
+    in.right = true;
+    in.shoot = true;
+    in.thrust = (tick % 120) < 10;
+    return in;
+}
+
+// Compara la rejilla espacial contra el doble bucle O(balas x asteroides) con
+// la mitad de entidades como asteroides y la otra mitad como balas. El mundo
+// crece con el número de entidades para mantener la densidad de 1000 entidades
+// en el tamaño del mundo; si no, el número de choques (la salida) crece al cuadrado.
+static int gridBench() {
+    const unsigned counts[] = {1000, 4000, 16000, 32000, 64000};
+    std::printf("%8s %12s %12s %12s %10s\n", "entidades", "rejilla ms", "bruta ms", "candidatos", "choques");
+    for (unsigned n : counts) {
+        unsigned na = n/2, nb = n - na;
+        float scale = std::sqrt(n / 1000.f);
+        int W = (int)(WORLD_WIDTH * scale), H = (int)(WORLD_HEIGHT * scale);
+        std::vector<sf::Vector2f> apos(na), bpos(nb);
+        std::vector<float> arad(na);
+        // posiciones también fuera del mundo, como en el margen de envolvimiento
+        for (unsigned i=0;i<na;i++) {
+            apos[i] = {std::rand()%(W+80) - 40.f, std::rand()%(H+80) - 40.f};
+            arad[i] = 6.f + std::rand()%43; // 6..48 como hijos y asteroides grandes
+        }
+        for (unsigned i=0;i<nb;i++) bpos[i] = {std::rand()%(W+20) - 10.f, std::rand()%(H+20) - 10.f};
+
+        auto hits = [&](unsigned b, unsigned a) {
+            float dx = bpos[b].x - apos[a].x, dy = bpos[b].y - apos[a].y, r = 3.f + arad[a];
+            return dx*dx + dy*dy <= r*r;
+        };
+
+        SpatialGrid grid((float)W, (float)H, 64.f);
+        std::vector<std::uint32_t> cand;
+        const int reps = 5;
+        unsigned long gridHits = 0, candidates = 0;
+        auto t0 = std::chrono::steady_clock::now();
+        for (int r=0;r<reps;r++) {
+            gridHits = 0; candidates = 0;
+            grid.clear();
+            for (unsigned i=0;i<na;i++) grid.insert(i, apos[i], arad[i]);
+            grid.build();
+            for (unsigned b=0;b<nb;b++) {
+                grid.query(bpos[b], 3.f, cand);
+                candidates += cand.size();
+                for (std::uint32_t a : cand) if (hits(b, a)) gridHits++;
+            }
+        }
+        double gridMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count() / reps;
+
+        // la fuerza bruta solo se mide donde termina en un tiempo razonable
+        double bruteMs = -1.0;
+        if (n <= 16000) {
+            unsigned long bruteHits = 0;
+            t0 = std::chrono::steady_clock::now();
+            for (unsigned b=0;b<nb;b++) for (unsigned a=0;a<na;a++) if (hits(b, a)) bruteHits++;
+            bruteMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+            if (bruteHits != gridHits) {
+                std::fprintf(stderr, "ERROR: la rejilla encontró %lu choques y la fuerza bruta %lu\n", gridHits, bruteHits);
+                return 1;
+            }
+        }
+        if (bruteMs < 0.0) std::printf("%8u %12.3f %12s %12lu %10lu\n", n, gridMs, "-", candidates, gridHits);
+        else std::printf("%8u %12.3f %12.3f %12lu %10lu\n", n, gridMs, bruteMs, candidates, gridHits);
+    }
+    return 0;
+}
+
+// Mide un tick de BulletStore y AsteroidStore con 100k entidades cada uno.
+static int kernelBench() {
+    const unsigned n = 100000;
+    const int reps = 200;
+    const float dt = 1.f/60.f;
+    BulletStore bullets;
+    AsteroidStore asteroids;
+    bullets.init(n);
+    asteroids.init(n);
+    std::vector<std::uint32_t> expired(n);
+    for (unsigned i=0;i<n;i++) {
+        Bullet b;
+        b.position = {float(std::rand()%(int)WORLD_WIDTH), float(std::rand()%(int)WORLD_HEIGHT)};
+        b.prevPosition = b.position;
+        b.velocity = {float(std::rand()%800 - 400), float(std::rand()%800 - 400)};
+        b.lifetime = 1e6f; // que no mueran durante la medición
+        bullets.spawn(b);
+        Asteroid a;
+        a.position = {float(std::rand()%(int)WORLD_WIDTH), float(std::rand()%(int)WORLD_HEIGHT)};
+        a.prevPosition = a.position;
+        a.velocity = {float(std::rand()%200 - 100), float(std::rand()%200 - 100)};
+        a.radius = 6.f + std::rand()%43;
+        asteroids.spawn(a);
+    }
+    auto t0 = std::chrono::steady_clock::now();
+    for (int r=0;r<reps;r++) bullets.update(dt, WORLD_WIDTH, WORLD_HEIGHT, expired.data());
+    double bulletUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count() / reps;
+    t0 = std::chrono::steady_clock::now();
+    for (int r=0;r<reps;r++) asteroids.update(dt, WORLD_WIDTH, WORLD_HEIGHT);
+    double asteroidUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count() / reps;
+    std::printf("simd:                %s\n", simdPathName());
+    std::printf("100k balas:          %.1f us/tick\n", bulletUs);
+    std::printf("100k asteroides:     %.1f us/tick\n", asteroidUs);
+    return 0;
+}
+
+// Tiempo de update() y de armar los vértices con 50k partículas vivas, lo
+// que cuesta una pantalla llena de explosiones en cada frame.
+static int particleBench() {
+    const unsigned n = 50000;
+    const int reps = 200;
+    ParticleSystem particles;
+    particles.init(n);
+    ParticleSystem::Burst b;
+    b.origin = {WORLD_WIDTH * 0.5f, WORLD_HEIGHT * 0.5f};
+    b.minLife = b.maxLife = 1e6f; // que no mueran durante la medición
+    particles.emit(b, n);
+    sf::VertexArray vertices(sf::Triangles);
+    auto t0 = std::chrono::steady_clock::now();
+    for (int r=0;r<reps;r++) particles.update(1.f/60.f);
+    double updateUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count() / reps;
+    t0 = std::chrono::steady_clock::now();
+    for (int r=0;r<reps;r++) particles.buildVertices(vertices, 0.f);
+    double buildUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count() / reps;
+    std::printf("50k particulas:      %.1f us/update, %.1f us/vertices (%zu vertices, 1 llamada)\n",
+                updateUs, buildUs, vertices.getVertexCount());
+    return 0;
+}
+
+// Arma los lotes de un frame como Game::render con cada vez más asteroides y
+// muestra que las llamadas de dibujo no crecen. No necesita ventana: cuenta
+// los lotes en lugar de dibujarlos.
+static int batchCheck() {
+    sf::Texture atlas; // solo se usa como identidad del lote
+    std::printf("%10s %10s %10s\n", "asteroides", "llamadas", "vertices");
+    for (unsigned n : {10u, 1000u, 10000u, 100000u}) {
+        World world(n + 64, 256);
+        world.asteroids.sprite.texture = &atlas;
+        world.asteroids.sprite.uv = sf::FloatRect(0.f, 0.f, 256.f, 256.f);
+        world.newGame();
+        world.spawnAsteroids(n);
+        for (int i=0;i<200;i++) world.bullets.spawn(world.player.shoot());
+        world.flushCommands();
+        SpriteBatch batch;
+        batch.begin();
+        for (size_t i=0;i<world.bullets.slots();++i) world.bullets.get(i).draw(batch);
+        for (size_t i=0;i<world.asteroids.slots();++i) world.asteroids.get(i).draw(batch);
+        world.player.draw(batch);
+        std::printf("%10zu %10zu %10zu\n", world.asteroids.live(), batch.batchCount(), batch.vertexCount());
+    }
+    return 0;
+}
+
+// Juega una partida con el guion rebobinando 5 s cada 12 s y la compara con
+// la misma partida sin rebobinar: al final la huella tiene que ser la misma.
+// Después guarda el estado en un archivo, lo carga en otro World y compara.
+static int rewindCheck(float dt, unsigned seed) {
+    const unsigned long ticks = (unsigned long)std::lround(60.f / dt);
+    const size_t rewindTicks = (size_t)std::lround(5.f / dt);
+    World reference, world;
+    reference.seed(seed); reference.newGame();
+    world.seed(seed); world.newGame();
+    for (unsigned long t = 0; t < ticks; ++t) reference.step(dt, scriptedInput(t));
+
+    // un estado cada 0.1 s, 10 s hacia atrás
+    RewindBuffer rewind;
+    const unsigned interval = std::max(1u, (unsigned)std::lround(0.1f / dt));
+    rewind.configure(interval, (size_t)(10.f / (interval * dt)));
+    rewind.reset(world);
+    double recordUs = 0.0, rewindUs = 0.0;
+    unsigned rewinds = 0;
+    unsigned long nextRewind = (unsigned long)std::lround(12.f / dt);
+    size_t peakBytes = 0;
+    for (unsigned long t = 0; t < ticks;) {
+        world.step(dt, scriptedInput(t));
+        auto t0 = std::chrono::steady_clock::now();
+        rewind.record(world);
+        recordUs += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+        peakBytes = std::max(peakBytes, rewind.storedBytes());
+        if (++t == nextRewind) {
+            t0 = std::chrono::steady_clock::now();
+            long long restored = rewind.rewind(world, rewindTicks);
+            rewindUs += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+            if (restored < 0) {
+                std::fprintf(stderr, "ERROR: no se pudo rebobinar en el tick %lu\n", t);
+                return 1;
+            }
+            t = (unsigned long)restored;
+            nextRewind += (unsigned long)std::lround(12.f / dt);
+            rewinds++;
+        }
+    }
+    const bool sameGame = world.checksum() == reference.checksum();
+
+    WorldState state;
+    state.capture(world);
+    const std::string path = "rewind-check.sav";
+    WorldState loaded;
+    World copy;
+    const bool saved = state.save(path) && loaded.load(path) && loaded.restore(copy);
+    std::remove(path.c_str());
+    WorldState again;
+    again.capture(copy);
+    const bool sameFile = saved && again.bytes == state.bytes && copy.checksum() == world.checksum();
+
+    std::printf("ticks:              %lu (%u rebobinados de %zu ticks)\n", ticks, rewinds, rewindTicks);
+    std::printf("estado entero:      %zu bytes (%zu asteroides, %zu balas)\n", state.bytes.size(),
+                world.asteroids.live(), world.bullets.live());
+    std::printf("anillo:             %zu estados, %zu bytes (pico %zu), %.1f s hacia atras\n", rewind.count(),
+                rewind.storedBytes(), peakBytes, rewind.secondsAvailable(dt));
+    std::printf("delta (media):      %zu bytes\n", rewind.averageDeltaBytes());
+    std::printf("record():           %.2f us/tick (media)\n", recordUs / ticks);
+    std::printf("rewind():           %.1f us (media)\n", rewinds ? rewindUs / rewinds : 0.0);
+    std::printf("huella rebobinando: %s\n", sameGame ? "igual" : "DISTINTA");
+    std::printf("guardar y cargar:   %s\n", sameFile ? "igual" : "DISTINTO");
+    return sameGame && sameFile ? 0 : 1;
+}
+
+// Prueba de resistencia: el piloto automático juega partida tras partida
+// (cada una con la semilla siguiente, como la R del juego) tan rápido como se
+// pueda hasta cumplir la duración. Sale con 2 si la memoria o el tick derivan.
+static int soak(World& world, float dt, unsigned seed, const SoakLimits& limits) {
+    SoakMonitor monitor;
+    monitor.begin(limits);
+    unsigned games = 0;
+    unsigned long totalTicks = 0;
+    auto newGame = [&] {
+        world.seed(seed + games++);
+        world.newGame();
+    };
+    newGame();
+    for (;;) {
+        if (world.isGameOver()) newGame();
+        ShipInput in = autopilotInput(world, world.player);
+        auto t0 = std::chrono::steady_clock::now();
+        world.step(dt, in);
+        monitor.addTick(std::chrono::duration<float>(std::chrono::steady_clock::now() - t0).count());
+        totalTicks++;
+        // leer el reloj en cada tick costaría más que el tick en partidas tranquilas
+        if ((totalTicks & 255) == 0 && !monitor.poll(world, games)) break;
+    }
+    std::printf("soak: %u partidas, %lu ticks, mejor puntuacion %d\n", games, totalTicks, world.maxScore);
+    return monitor.finish() ? 0 : 2;
+}
+
+// Partida en red a tiempo real (un tick cada `dt`). Con `port` >= 0 el guion
+// hospeda y `clientCount` clientes del mismo proceso se unen por localhost,
+// cada uno con el guion desfasado; con `connectTo` solo se une a otro
+// anfitrión. Las partidas perdidas se reinician como con R en el juego.
+static int runNetwork(int port, const std::string& connectTo, unsigned clientCount, float snapshotRate,
+                      unsigned long maxTicks, float dt, unsigned seed, unsigned extraAsteroids) {
+    World world;
+    NetServer server;
+    std::vector<std::unique_ptr<NetClient>> clients;
+    std::vector<std::unique_ptr<World>> clientWorlds;
+    auto join = [&](const std::string& host, unsigned short p) {
+        clients.emplace_back(new NetClient());
+        clientWorlds.emplace_back(new World());
+        return clients.back()->connect(host, p, 1.f / dt);
+    };
+    if (port >= 0) {
+        if (!server.start((unsigned short)port, 1.f / dt, snapshotRate)) return 1;
+        for (unsigned i = 0; i < clientCount; ++i)
+            if (!join("127.0.0.1", server.port() ? server.port() : (unsigned short)port)) return 1;
+    } else {
+        size_t colon = connectTo.rfind(':');
+        if (colon == std::string::npos || !join(connectTo.substr(0, colon), (unsigned short)std::atoi(connectTo.c_str() + colon + 1))) {
+            std::fprintf(stderr, "no se pudo conectar a %s (HOST:PUERTO)\n", connectTo.c_str());
+            return 1;
+        }
+    }
+    auto newGame = [&](unsigned g) {
+        world.seed(seed + g);
+        world.newGame();
+        world.spawnAsteroids(extraAsteroids);
+        world.flushCommands();
+    };
+    unsigned games = 0;
+    if (server.running()) newGame(games++);
+
+    const auto tickTime = std::chrono::duration<double>(dt);
+    const unsigned long reportEvery = (unsigned long)std::max(1.f, 5.f / dt);
+    size_t peakAsteroids = 0;
+    auto report = [&](unsigned long t) {
+        if (server.running())
+            std::printf("tick %lu: %zu asteroides, %zu balas, %zu naves invitadas\n", t,
+                        world.asteroids.live(), world.bullets.live(), world.guests.size());
+        else
+            std::printf("tick %lu\n", t);
+        std::printf("%s", server.describe().c_str());
+        for (size_t i = 0; i < clients.size(); ++i)
+            std::printf("  %s (ve %zu asteroides)\n", clients[i]->describe().c_str(), clientWorlds[i]->asteroids.live());
+    };
+    auto next = std::chrono::steady_clock::now();
+    for (unsigned long t = 0; t < maxTicks; ++t) {
+        if (server.running()) {
+            server.receive(world);
+            world.step(dt, scriptedInput(t));
+            if (world.isGameOver()) newGame(games++);
+            server.send(world);
+            peakAsteroids = std::max(peakAsteroids, world.asteroids.live());
+        }
+        for (size_t i = 0; i < clients.size(); ++i) {
+            clients[i]->update(*clientWorlds[i], scriptedInput(t + 37 * (i + 1)));
+            if (clients[i]->timedOut()) {
+                std::fprintf(stderr, "sin respuesta del servidor: %s\n", clients[i]->describe().c_str());
+                return 1;
+            }
+        }
+        if ((t + 1) % reportEvery == 0) report(t + 1);
+        next += std::chrono::duration_cast<std::chrono::steady_clock::duration>(tickTime);
+        std::this_thread::sleep_until(next);
+    }
+    report(maxTicks);
+    if (server.running()) std::printf("partidas: %u, asteroides (pico): %zu\n", games, peakAsteroids);
+    for (const auto& c : clients)
+        if (!c->connected()) {
+            std::fprintf(stderr, "un cliente no recibio ninguna instantanea\n");
+            return 1;
+        }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    unsigned long maxTicks = 100000;
+    unsigned games = 1;
+    float dt = 1.f/60.f;
+    unsigned seed = 1;
+    std::string profilePath, recordPath, replayPath;
+    int threads = -1; // sin JobSystem
+    bool box2d = false;
+    int servePort = -1;
+    std::string connectTo;
+    unsigned netClients = 0, extraAsteroids = 0;
+    float snapshotRate = 20.f;
+    bool ticksGiven = false;
+    bool rewindCheckRequested = false;
+    bool autopilot = false;
+    SoakLimits soakLimits;
+    soakLimits.duration = 0.f; // sin --soak
+    for (int i=1;i<argc;i++) {
+        std::string arg = argv[i];
+        bool hasValue = i+1 < argc;
+        if (arg == "--grid-bench") return gridBench();
+        else if (arg == "--kernel-bench") return kernelBench();
+        else if (arg == "--batch-check") return batchCheck();
+        else if (arg == "--particle-bench") return particleBench();
+        else if (arg == "--rewind-check") rewindCheckRequested = true;
+        else if (arg == "--autopilot") autopilot = true;
+        else if (arg == "--soak" && hasValue) soakLimits.duration = std::strtof(argv[++i], nullptr);
+        else if (arg == "--soak-interval" && hasValue) soakLimits.interval = std::strtof(argv[++i], nullptr);
+        else if (arg == "--soak-max-rss" && hasValue) soakLimits.maxRssGrowthMB = std::strtod(argv[++i], nullptr);
+        else if (arg == "--soak-max-drift" && hasValue) soakLimits.maxTickDrift = std::strtod(argv[++i], nullptr) / 100.0;
+        else if (arg == "--ticks" && hasValue) { maxTicks = std::strtoul(argv[++i], nullptr, 10); ticksGiven = true; }
+        else if (arg == "--games" && hasValue) games = (unsigned)std::strtoul(argv[++i], nullptr, 10);
+        else if (arg == "--dt" && hasValue) dt = std::strtof(argv[++i], nullptr);
+        else if (arg == "--seed" && hasValue) seed = (unsigned)std::strtoul(argv[++i], nullptr, 10);
+        else if (arg == "--profile" && hasValue) profilePath = argv[++i];
+        else if (arg == "--record" && hasValue) recordPath = argv[++i];
+        else if (arg == "--replay" && hasValue) replayPath = argv[++i];
+        else if (arg == "--threads" && hasValue) threads = std::atoi(argv[++i]);
+        else if (arg == "--physics" && hasValue && (std::string(argv[i+1]) == "propio" || std::string(argv[i+1]) == "box2d"))
+            box2d = std::string(argv[++i]) == "box2d";
+        else if (arg == "--serve" && hasValue) servePort = std::atoi(argv[++i]);
+        else if (arg == "--connect" && hasValue) connectTo = argv[++i];
+        else if (arg == "--clients" && hasValue) netClients = (unsigned)std::strtoul(argv[++i], nullptr, 10);
+        else if (arg == "--snapshot-rate" && hasValue) snapshotRate = std::strtof(argv[++i], nullptr);
+        else if (arg == "--asteroids" && hasValue) extraAsteroids = (unsigned)std::strtoul(argv[++i], nullptr, 10);
+        else {
+            std::fprintf(stderr, "uso: %s [--ticks N] [--games N] [--dt S] [--seed N] [--profile ARCHIVO] [--record ARCHIVO] [--replay ARCHIVO] [--threads N] [--physics propio|box2d] [--autopilot] | --soak SEGUNDOS [--soak-interval S] [--soak-max-rss MB] [--soak-max-drift PCT] | --serve PUERTO [--clients N] [--snapshot-rate HZ] [--asteroids N] | --connect HOST:PUERTO | --grid-bench | --kernel-bench | --batch-check | --particle-bench | --rewind-check\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (rewindCheckRequested) return rewindCheck(dt, seed);
+    // en red se juega a tiempo real: por defecto un minuto
+    if (servePort >= 0 || !connectTo.empty())
+        return runNetwork(servePort, connectTo, netClients, snapshotRate, ticksGiven ? maxTicks : (unsigned long)(60.f / dt),
+                          dt, seed, extraAsteroids);
+
+    // --replay: la entrada grabada reemplaza al guion (una partida, con su semilla y dt)
+    Replay replay;
+    const bool replaying = !replayPath.empty();
+    if (replaying) {
+        if (!replay.load(replayPath)) {
+            std::fprintf(stderr, "no se pudo leer la repeticion %s\n", replayPath.c_str());
+            return 1;
+        }
+        games = 1;
+        maxTicks = replay.ticks();
+        dt = replay.dt;
+    }
+    // --record: graba la primera partida
+    Replay recording;
+
+    World world;
+    // --threads N: N hilos de trabajo además del principal (0 = según los núcleos)
+    std::unique_ptr<JobSystem> jobs;
+    if (threads >= 0) {
+        jobs.reset(new JobSystem((unsigned)threads));
+        world.jobs = jobs.get();
+    }
+    // --physics box2d: integración y contactos con Box2D (las repeticiones solo
+    // coinciden con el mismo motor con que se grabaron)
+    std::unique_ptr<Box2DPhysics> physics;
+    if (box2d) {
+        if (!Box2DPhysics::available()) {
+            std::fprintf(stderr, "compilado sin Box2D (make BOX2D=1)\n");
+            return 1;
+        }
+        physics = std::make_unique<Box2DPhysics>();
+        world.physics = physics.get();
+    }
+    if (soakLimits.duration > 0.f) return soak(world, dt, seed, soakLimits);
+    // con --profile cada tick es un "frame" del perfilador
+    Profiler profiler(4096);
+    if (!profilePath.empty()) {
+        profiler.setRecording(true);
+        world.profiler = &profiler;
+    }
+
+    unsigned long totalTicks = 0;
+    unsigned long entitySum = 0;
+    size_t peakEntities = 0;
+    long long scoreSum = 0;
+    unsigned long stepAllocations = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned g=0; g<games; g++) {
+        // cada partida con su semilla, para poder repetir cualquiera por separado
+        std::uint64_t gameSeed = replaying ? replay.seed : seed + g;
+        const bool recordThis = g == 0 && !recordPath.empty();
+        world.seed(gameSeed);
+        world.newGame();
+        if (recordThis) recording.begin(gameSeed, dt);
+        // cada partida termina al perder todas las vidas o al llegar al límite de ticks
+        for (unsigned long t=0; t<maxTicks && !world.isGameOver(); t++) {
+            ShipInput in = replaying ? replay.input(t) : autopilot ? autopilotInput(world, world.player) : scriptedInput(t);
+            if (recordThis) recording.record(in);
+            unsigned long before = allocationCount();
+            if (world.profiler) profiler.beginFrame();
+            world.step(dt, in);
+            if (world.profiler) profiler.endFrame();
+            stepAllocations += allocationCount() - before;
+            size_t n = world.asteroids.live() + world.bullets.live();
+            entitySum += n;
+            if (n > peakEntities) peakEntities = n;
+            totalTicks++;
+        }
+        scoreSum += world.score;
+        if (recordThis) {
+            recording.finalChecksum = world.checksum();
+            if (!recording.save(recordPath)) std::fprintf(stderr, "no se pudo escribir %s\n", recordPath.c_str());
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("partidas:          %u\n", games);
+    std::printf("ticks:             %lu\n", totalTicks);
+    std::printf("tiempo:            %.3f s\n", seconds);
+    std::printf("ticks/s:           %.0f\n", seconds > 0.0 ? totalTicks / seconds : 0.0);
+    std::printf("entidades (media): %.1f\n", totalTicks ? (double)entitySum / totalTicks : 0.0);
+    std::printf("entidades (pico):  %zu\n", peakEntities);
+    std::printf("puntos (media):    %.1f\n", games ? (double)scoreSum / games : 0.0);
+    std::printf("mejor puntuacion:  %d\n", world.maxScore);
+    std::printf("asignaciones/tick: %.4f\n", totalTicks ? (double)stepAllocations / totalTicks : 0.0);
+    std::printf("altas descartadas: %u\n", world.droppedSpawns);
+    if (world.profiler) {
+        std::printf("\n%s", profiler.table().c_str());
+        if (!profiler.write(profilePath)) std::fprintf(stderr, "no se pudo escribir %s\n", profilePath.c_str());
+    }
+    if (replaying) {
+        // misma huella = misma partida bit a bit
+        std::uint64_t check = world.checksum();
+        bool same = check == replay.finalChecksum;
+        std::printf("huella:            %016llx (%s)\n", (unsigned long long)check,
+                    same ? "igual a la grabada" : "DISTINTA de la grabada");
+        return same ? 0 : 2;
+    }
+    return 0;
+}
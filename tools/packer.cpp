@@ -0,0 +1,138 @@
+// Empaqueta los recursos del juego en un solo archivo (make pack) con el
+// formato de AssetPack.hpp: imágenes decodificadas a RGBA, efectos cortos
+// decodificados a PCM y el resto (fuentes, canciones) tal cual.
+//
+// Uso: AssetsPacker.exe SALIDA.pak [--pcm-max-seconds S] ARCHIVO...
+#include "AssetPack.hpp"
+#include <SFML/Audio.hpp>
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+struct PackedFile {
+    std::string name;
+    PackEntryKind kind = PackEntryKind::Raw;
+    std::vector<std::uint8_t> bytes;
+    std::uint32_t a = 0, b = 0;
+};
+
+static void putInt(std::vector<std::uint8_t>& out, std::uint64_t v, int bytes) {
+    for (int i = 0; i < bytes; ++i) out.push_back((std::uint8_t)(v >> (8*i)));
+}
+
+static std::string extension(const std::string& path) {
+    size_t dot = path.find_last_of('.');
+    std::string ext = dot == std::string::npos ? "" : path.substr(dot + 1);
+    for (char& c : ext) c = (char)std::tolower((unsigned char)c);
+    return ext;
+}
+
+static bool readRaw(const std::string& path, std::vector<std::uint8_t>& out) {
+    FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f) return false;
+    std::uint8_t buf[1 << 16];
+    size_t n;
+    while ((n = std::fread(buf, 1, sizeof(buf), f)) > 0) out.insert(out.end(), buf, buf + n);
+    std::fclose(f);
+    return true;
+}
+
+static bool packFile(const std::string& path, float pcmMaxSeconds, PackedFile& out) {
+    out.name = path;
+    std::string ext = extension(path);
+    if (ext == "png" || ext == "jpg" || ext == "jpeg" || ext == "bmp" || ext == "tga") {
+        sf::Image img;
+        if (img.loadFromFile(path) && img.getPixelsPtr()) {
+            sf::Vector2u size = img.getSize();
+            out.kind = PackEntryKind::Rgba;
+            out.a = size.x;
+            out.b = size.y;
+            out.bytes.assign(img.getPixelsPtr(), img.getPixelsPtr() + (size_t)size.x * size.y * 4);
+            return true;
+        }
+    } else if (ext == "wav" || ext == "ogg" || ext == "flac" || ext == "mp3") {
+        // solo los efectos cortos: las canciones decodificadas ocuparían decenas de MB
+        sf::SoundBuffer sound;
+        if (sound.loadFromFile(path) && sound.getDuration().asSeconds() <= pcmMaxSeconds) {
+            out.kind = PackEntryKind::Pcm;
+            out.a = sound.getSampleRate();
+            out.b = sound.getChannelCount();
+            const sf::Int16* samples = sound.getSamples();
+            for (sf::Uint64 i = 0; i < sound.getSampleCount(); ++i) putInt(out.bytes, (std::uint16_t)samples[i], 2);
+            return true;
+        }
+    }
+    out.kind = PackEntryKind::Raw;
+    return readRaw(path, out.bytes);
+}
+
+int main(int argc, char** argv) {
+    std::string outPath;
+    float pcmMaxSeconds = 5.f;
+    std::vector<std::string> inputs;
+    for (int i=1;i<argc;i++) {
+        std::string arg = argv[i];
+        if (arg == "--pcm-max-seconds" && i+1 < argc) pcmMaxSeconds = std::strtof(argv[++i], nullptr);
+        else if (outPath.empty()) outPath = arg;
+        else inputs.push_back(arg);
+    }
+    if (outPath.empty() || inputs.empty()) {
+        std::fprintf(stderr, "uso: %s SALIDA.pak [--pcm-max-seconds S] ARCHIVO...\n", argv[0]);
+        return 1;
+    }
+
+    // el índice va ordenado por nombre para buscar con búsqueda binaria
+    std::sort(inputs.begin(), inputs.end());
+    inputs.erase(std::unique(inputs.begin(), inputs.end()), inputs.end());
+
+    std::vector<std::uint8_t> out(ASSET_PACK_MAGIC, ASSET_PACK_MAGIC + 4);
+    putInt(out, ASSET_PACK_VERSION, 4);
+    putInt(out, 0, 4); // entradas y desplazamiento del índice: se rellenan al final
+    putInt(out, 0, 4);
+    std::vector<std::uint8_t> toc;
+    std::uint32_t count = 0;
+    static const char* kindNames[] = {"raw", "rgba", "pcm"};
+    for (const std::string& path : inputs) {
+        PackedFile file;
+        if (!packFile(path, pcmMaxSeconds, file)) {
+            std::fprintf(stderr, "no se pudo leer %s\n", path.c_str());
+            return 1;
+        }
+        while (out.size() % ASSET_PACK_ALIGN) out.push_back(0);
+        std::uint32_t offset = (std::uint32_t)out.size();
+        out.insert(out.end(), file.bytes.begin(), file.bytes.end());
+
+        putInt(toc, file.name.size(), 2);
+        toc.insert(toc.end(), file.name.begin(), file.name.end());
+        putInt(toc, (std::uint8_t)file.kind, 1);
+        putInt(toc, offset, 4);
+        putInt(toc, file.bytes.size(), 4);
+        putInt(toc, file.a, 4);
+        putInt(toc, file.b, 4);
+        count++;
+        std::printf("%-44s %-4s %10zu bytes\n", path.c_str(), kindNames[(int)file.kind], file.bytes.size());
+    }
+    std::uint32_t tocOffset = (std::uint32_t)out.size();
+    out.insert(out.end(), toc.begin(), toc.end());
+    for (int i = 0; i < 4; ++i) {
+        out[8 + i] = (std::uint8_t)(count >> (8*i));
+        out[12 + i] = (std::uint8_t)(tocOffset >> (8*i));
+    }
+
+    FILE* f = std::fopen(outPath.c_str(), "wb");
+    if (!f) {
+        std::fprintf(stderr, "no se pudo abrir %s\n", outPath.c_str());
+        return 1;
+    }
+    bool ok = std::fwrite(out.data(), 1, out.size(), f) == out.size();
+    if (std::fclose(f) != 0 || !ok) {
+        std::fprintf(stderr, "error al escribir %s\n", outPath.c_str());
+        return 1;
+    }
+    std::printf("%s: %u entradas, %zu bytes\n", outPath.c_str(), count, out.size());
+    return 0;
+}